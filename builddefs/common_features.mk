@@ -44,6 +44,10 @@ else ifeq ($(strip $(DEBUG_MATRIX_SCAN_RATE_ENABLE)), api)
     OPT_DEFS += -DDEBUG_MATRIX_SCAN_RATE
 endif
 
+ifeq ($(strip $(SEND_STRING_ASYNC_ENABLE)), yes)
+    OPT_DEFS += -DSEND_STRING_ASYNC_ENABLE
+endif
+
 AUDIO_ENABLE ?= no
 ifeq ($(strip $(AUDIO_ENABLE)), yes)
     ifeq ($(PLATFORM),CHIBIOS)
@@ -86,8 +90,6 @@ ifeq ($(strip $(MIDI_ENABLE)), yes)
     SRC += $(QUANTUM_DIR)/midi/midi_device.c
     SRC += $(QUANTUM_DIR)/midi/qmk_midi.c
     SRC += $(QUANTUM_DIR)/midi/sysex_tools.c
-    SRC += $(QUANTUM_DIR)/midi/bytequeue/bytequeue.c
-    SRC += $(QUANTUM_DIR)/midi/bytequeue/interrupt_setting.c
     SRC += $(QUANTUM_DIR)/process_keycode/process_midi.c
 endif
 
@@ -618,6 +620,20 @@ ifeq ($(strip $(VIA_ENABLE)), yes)
     RAW_ENABLE := yes
     BOOTMAGIC_ENABLE := yes
     TRI_LAYER_ENABLE := yes
+
+    RAW_HID_ROUTER_ENABLE := yes
+endif
+
+ifeq ($(strip $(VIA_BULK_TRANSFER_ENABLE)), yes)
+    OPT_DEFS += -DVIA_BULK_TRANSFER_ENABLE
+    CRC_ENABLE := yes
+    SRC += $(QUANTUM_DIR)/via_bulk_transfer.c
+endif
+
+ifeq ($(strip $(RAW_HID_ROUTER_ENABLE)), yes)
+    RAW_ENABLE := yes
+    OPT_DEFS += -DRAW_HID_ROUTER_ENABLE
+    SRC += $(QUANTUM_DIR)/raw_hid.c
 endif
 
 VALID_CUSTOM_MATRIX_TYPES:= yes lite no
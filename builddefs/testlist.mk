@@ -1,5 +1,7 @@
 TEST_LIST = $(sort $(patsubst %/test.mk,%, $(shell find $(ROOT_DIR)tests -type f -name test.mk)))
 FULL_TESTS := $(notdir $(TEST_LIST))
+# Benchmarks only report timings and take a while, so test:all skips them and they run when named
+OPT_IN_TEST_LIST := $(filter %/tests/benchmark,$(TEST_LIST))
 
 include $(QUANTUM_PATH)/debounce/tests/testlist.mk
 include $(QUANTUM_PATH)/encoder/tests/testlist.mk
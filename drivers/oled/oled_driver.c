@@ -165,6 +165,11 @@ uint32_t oled_scroll_timeout;
 #if OLED_UPDATE_INTERVAL > 0
 uint16_t oled_update_timeout;
 #endif
+#if defined(OLED_DIFF_UPDATES)
+// Copy of the display buffer as last sent to the panel, so that only changed bytes need to be transmitted
+static uint8_t         oled_shadow_buffer[OLED_MATRIX_SIZE];
+static OLED_BLOCK_TYPE oled_shadow_valid = 0;
+#endif
 
 #if defined(OLED_TRANSPORT_SPI)
 #    ifndef OLED_DC_PIN
@@ -363,6 +368,9 @@ bool oled_init(oled_rotation_t rotation) {
 #endif
 
     oled_clear();
+#if defined(OLED_DIFF_UPDATES)
+    oled_shadow_valid = 0;
+#endif
     oled_initialized = true;
     oled_active      = true;
     oled_scrolling   = false;
@@ -446,9 +454,84 @@ static void rotate_90(const uint8_t *src, uint8_t *dest) {
     }
 }
 
+#if defined(OLED_DIFF_UPDATES)
+// Clears the dirty flag of any block whose contents already match what the panel is showing
+static void oled_prune_unchanged_blocks(void) {
+    for (uint8_t i = 0; i < OLED_BLOCK_COUNT; ++i) {
+        OLED_BLOCK_TYPE block_mask = (OLED_BLOCK_TYPE)1 << i;
+        if ((oled_dirty & oled_shadow_valid & block_mask) && memcmp(&oled_buffer[OLED_BLOCK_SIZE * i], &oled_shadow_buffer[OLED_BLOCK_SIZE * i], OLED_BLOCK_SIZE) == 0) {
+            oled_dirty &= ~block_mask;
+        }
+    }
+}
+
+static void calc_bounds_range(uint16_t start, uint8_t length, uint8_t *cmd_array) {
+    // Calculate commands to set memory addressing bounds for a range of bytes within a single page.
+    uint8_t page   = start / OLED_DISPLAY_WIDTH;
+    uint8_t column = start % OLED_DISPLAY_WIDTH;
+#    if !OLED_IC_HAS_HORIZONTAL_MODE
+    cmd_array[0] = PAM_PAGE_ADDR | page;
+    cmd_array[1] = PAM_SETCOLUMN_LSB | ((OLED_COLUMN_OFFSET + column) & 0x0f);
+    cmd_array[2] = PAM_SETCOLUMN_MSB | ((OLED_COLUMN_OFFSET + column) >> 4 & 0x0f);
+#    else
+    cmd_array[1] = column + OLED_COLUMN_OFFSET;
+    cmd_array[2] = column + length - 1 + OLED_COLUMN_OFFSET;
+    cmd_array[4] = page;
+    cmd_array[5] = page;
+#    endif
+}
+
+// Sends only the changed byte ranges of a block, split at page boundaries
+static bool oled_render_block_diff(uint8_t block) {
+#    if OLED_IC_HAS_HORIZONTAL_MODE
+    static uint8_t display_start[] = {I2C_CMD, COLUMN_ADDR, 0, OLED_DISPLAY_WIDTH - 1, PAGE_ADDR, 0, OLED_DISPLAY_HEIGHT / 8 - 1};
+#    else
+    static uint8_t display_start[] = {I2C_CMD, PAM_PAGE_ADDR, PAM_SETCOLUMN_LSB, PAM_SETCOLUMN_MSB};
+#    endif
+
+    const uint16_t block_end = OLED_BLOCK_SIZE * (block + 1);
+    uint16_t       index     = OLED_BLOCK_SIZE * block;
+    while (index < block_end) {
+        uint16_t page_end = (index / OLED_DISPLAY_WIDTH + 1) * OLED_DISPLAY_WIDTH;
+        if (page_end > block_end) {
+            page_end = block_end;
+        }
+
+        // Find the first and last changed bytes within this page
+        uint16_t first = index;
+        uint16_t last  = page_end;
+        while (first < last && oled_buffer[first] == oled_shadow_buffer[first]) {
+            ++first;
+        }
+        while (last > first && oled_buffer[last - 1] == oled_shadow_buffer[last - 1]) {
+            --last;
+        }
+
+        if (first < last) {
+            calc_bounds_range(first, last - first, &display_start[1]); // Offset from I2C_CMD byte at the start
+            if (!oled_send_cmd(display_start, ARRAY_SIZE(display_start))) {
+                print("oled_render offset command failed\n");
+                return false;
+            }
+            if (!oled_send_data(&oled_buffer[first], last - first)) {
+                print("oled_render data failed\n");
+                return false;
+            }
+            memcpy(&oled_shadow_buffer[first], &oled_buffer[first], last - first);
+        }
+
+        index = page_end;
+    }
+    return true;
+}
+#endif // defined(OLED_DIFF_UPDATES)
+
 void oled_render_dirty(bool all) {
     // Do we have work to do?
     oled_dirty &= OLED_ALL_BLOCKS_MASK;
+#if defined(OLED_DIFF_UPDATES)
+    oled_prune_unchanged_blocks();
+#endif
     if (!oled_dirty || !oled_initialized || oled_scrolling) {
         return;
     }
@@ -464,6 +547,17 @@ void oled_render_dirty(bool all) {
             ++update_start;
         }
 
+#if defined(OLED_DIFF_UPDATES)
+        if (!HAS_FLAGS(oled_rotation, OLED_ROTATION_90) && (oled_shadow_valid & ((OLED_BLOCK_TYPE)1 << update_start))) {
+            // The panel already holds a known copy of this block, so only send what has changed
+            if (!oled_render_block_diff(update_start)) {
+                return;
+            }
+            oled_dirty &= ~((OLED_BLOCK_TYPE)1 << update_start);
+            continue;
+        }
+#endif
+
         // Set column & page position
 #if OLED_IC_HAS_HORIZONTAL_MODE
         static uint8_t display_start[] = {I2C_CMD, COLUMN_ADDR, 0, OLED_DISPLAY_WIDTH - 1, PAGE_ADDR, 0, OLED_DISPLAY_HEIGHT / 8 - 1};
@@ -527,6 +621,12 @@ void oled_render_dirty(bool all) {
 #endif
         }
 
+#if defined(OLED_DIFF_UPDATES)
+        // Remember what the panel is now showing for this block
+        memcpy(&oled_shadow_buffer[OLED_BLOCK_SIZE * update_start], &oled_buffer[OLED_BLOCK_SIZE * update_start], OLED_BLOCK_SIZE);
+        oled_shadow_valid |= ((OLED_BLOCK_TYPE)1 << update_start);
+#endif
+
         // Clear dirty flag of just rendered block
         oled_dirty &= ~((OLED_BLOCK_TYPE)1 << update_start);
     }
@@ -878,6 +978,9 @@ bool oled_scroll_off(void) {
         }
         oled_scrolling = false;
         oled_dirty     = OLED_ALL_BLOCKS_MASK;
+#if defined(OLED_DIFF_UPDATES)
+        oled_shadow_valid = 0;
+#endif
     }
     return !oled_scrolling;
 }
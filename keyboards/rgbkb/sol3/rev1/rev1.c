@@ -31,6 +31,15 @@ RGB rgb_matrix_hsv_to_rgb(HSV hsv) {
     return hsv_to_rgb(hsv);
 }
 
+void rgb_matrix_hsv_to_rgb_batch(const uint8_t *h, const uint8_t *s, const uint8_t *v, uint8_t *r, uint8_t *g, uint8_t *b, uint8_t count) {
+    for (uint8_t i = 0; i < count; i++) {
+        RGB rgb = rgb_matrix_hsv_to_rgb((HSV){.h = h[i], .s = s[i], .v = v[i]});
+        r[i]    = rgb.r;
+        g[i]    = rgb.g;
+        b[i]    = rgb.b;
+    }
+}
+
 bool dip_switch_update_kb(uint8_t index, bool active) {
     if (!dip_switch_update_user(index, active))
         return false;
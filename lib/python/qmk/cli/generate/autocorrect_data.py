@@ -24,12 +24,16 @@ Example:
   lenght        -> length
   ouput         -> output
   widht         -> width
+With --external-flash, the trie is written to "autocorrect_data.bin" instead, to
+be stored in external SPI flash, and "autocorrect_data.h" only describes it.
 For full documentation, see QMK Docs
 """
 
+import struct
 import sys
 import textwrap
-from typing import Any, Dict, Iterator, List, Tuple
+from collections import deque
+from typing import Any, Callable, Dict, Iterator, List, Tuple
 
 from milc import cli
 
@@ -43,6 +47,11 @@ KC_A = 4
 KC_SPC = 0x2c
 KC_QUOT = 0x34
 
+# Header of the external flash image, checked by the firmware before use:
+# magic, format version, trie size, min and max typo length, page size.
+FLASH_IMAGE_MAGIC = b'QAC\x01'
+FLASH_IMAGE_HEADER = struct.Struct('<4sIBBH4x')
+
 TYPO_CHARS = dict([
     ("'", KC_QUOT),
     (':', KC_SPC),  # "Word break" character.
@@ -80,6 +89,7 @@ def parse_file(file_name: str) -> List[Tuple[str, str]]:
 
     autocorrections = []
     typos = set()
+    substrings = {}  # Every substring of the typos seen so far, mapped to one typo containing it.
     for line_number, typo, correction in parse_file_lines(file_name):
         if typo in typos:
             cli.log.warning('{fg_red}Error:%d:{fg_reset} Ignoring duplicate typo: "{fg_cyan}%s{fg_reset}"', line_number, typo)
@@ -89,10 +99,10 @@ def parse_file(file_name: str) -> List[Tuple[str, str]]:
         if not (all([c in TYPO_CHARS for c in typo])):
             cli.log.error('{fg_red}Error:%d:{fg_reset} Typo "{fg_cyan}%s{fg_reset}" has characters other than a-z, \' and :.', line_number, typo)
             sys.exit(1)
-        for other_typo in typos:
-            if typo in other_typo or other_typo in typo:
-                cli.log.error('{fg_red}Error:%d:{fg_reset} Typos may not be substrings of one another, otherwise the longer typo would never trigger: "{fg_cyan}%s{fg_reset}" vs. "{fg_cyan}%s{fg_reset}".', line_number, typo, other_typo)
-                sys.exit(1)
+        other_typo = find_substring_typo(typo, typos, substrings)
+        if other_typo:
+            cli.log.error('{fg_red}Error:%d:{fg_reset} Typos may not be substrings of one another, otherwise the longer typo would never trigger: "{fg_cyan}%s{fg_reset}" vs. "{fg_cyan}%s{fg_reset}".', line_number, typo, other_typo)
+            sys.exit(1)
         if len(typo) < 5:
             cli.log.warning('{fg_yellow}Warning:%d:{fg_reset} It is suggested that typos are at least 5 characters long to avoid false triggers: "{fg_cyan}%s{fg_reset}"', line_number, typo)
         if len(typo) > 127:
@@ -103,10 +113,33 @@ def parse_file(file_name: str) -> List[Tuple[str, str]]:
 
         autocorrections.append((typo, correction))
         typos.add(typo)
+        for substring in substrings_of(typo):
+            substrings.setdefault(substring, typo)
 
     return autocorrections
 
 
+def substrings_of(typo: str) -> Iterator[str]:
+    """Yields every non-empty substring of `typo`."""
+    for start in range(len(typo)):
+        for end in range(start + 1, len(typo) + 1):
+            yield typo[start:end]
+
+
+def find_substring_typo(typo: str, typos, substrings: Dict[str, str]) -> str:
+    """Returns a known typo that contains `typo` or is contained in it, if any.
+
+  This keeps dictionaries of tens of thousands of typos fast to check, where
+  comparing every pair of typos would not be.
+  """
+    if typo in substrings:
+        return substrings[typo]
+    for substring in substrings_of(typo):
+        if substring in typos:
+            return substring
+    return ''
+
+
 def make_trie(autocorrections: List[Tuple[str, str]]) -> Dict[str, Any]:
     """Makes a trie from the the typos, writing in reverse.
   Args:
@@ -165,11 +198,13 @@ def check_typo_against_dictionary(typo: str, line_number: int, correct_words) ->
                 cli.log.warning('{fg_yellow}Warning:%d:{fg_reset} Typo "{fg_cyan}%s{fg_reset}" would falsely trigger on correctly spelled word "{fg_cyan}%s{fg_reset}".', line_number, typo, word)
 
 
-def serialize_trie(autocorrections: List[Tuple[str, str]], trie: Dict[str, Any]) -> List[int]:
+def serialize_trie(autocorrections: List[Tuple[str, str]], trie: Dict[str, Any], link_size: int = 2, page_size: int = 0) -> List[int]:
     """Serializes trie and correction data in a form readable by the C code.
   Args:
     autocorrections: List of (typo, correction) tuples.
     trie: Dict of dicts.
+    link_size: Number of bytes in a node link.
+    page_size: If non-zero, lay the table out in pages of this size for external flash.
   Returns:
     List of ints in the range 0-255.
   """
@@ -210,7 +245,7 @@ def serialize_trie(autocorrections: List[Tuple[str, str]], trie: Dict[str, Any])
             entry['links'] = [traverse(trie_node[c]) for c in entry['chars']]
         return entry
 
-    traverse(trie)
+    root = traverse(trie)
 
     def serialize(e: Dict[str, Any]) -> List[int]:
         if not e['links']:  # Handle a leaf table entry.
@@ -220,25 +255,65 @@ def serialize_trie(autocorrections: List[Tuple[str, str]], trie: Dict[str, Any])
         else:  # Handle a branch table entry.
             data = []
             for c, link in zip(e['chars'], e['links']):
-                data += [TYPO_CHARS[c] | (0 if data else 64)] + encode_link(link)
+                data += [TYPO_CHARS[c] | (0 if data else 64)] + encode_link(link, link_size)
             return data + [0]
 
+    if page_size:
+        table = layout_pages(root, page_size, lambda e: len(serialize(e)))
+
     byte_offset = 0
     for e in table:  # To encode links, first compute byte offset of each entry.
         e['byte_offset'] = byte_offset
         byte_offset += len(serialize(e))
-        assert 0 <= byte_offset <= 0xffff
+        assert 0 <= byte_offset < 1 << (8 * link_size)
 
     return [b for e in table for b in serialize(e)]  # Serialize final table.
 
 
-def encode_link(link: Dict[str, Any]) -> List[int]:
-    """Encodes a node link as two bytes."""
+def layout_pages(root: Dict[str, Any], page_size: int, entry_size: Callable[[Dict[str, Any]], int]) -> List[Dict[str, Any]]:
+    """Orders table entries for reading from external flash through a page cache.
+  Entries are placed breadth first, so the top levels of the trie share the first
+  pages, and padding keeps an entry from straddling two pages where it fits in one.
+  A chain is always followed by its child, as the C code falls through to it.
+  Args:
+    root: Root table entry.
+    page_size: Size of a cache page in bytes.
+    entry_size: Returns the serialized size of an entry.
+  Returns:
+    Table entries in layout order, including padding entries.
+  """
+    layout = []
+    offset = 0
+    queue = deque([root])
+    while queue:
+        group = [queue.popleft()]
+        if len(group[0]['links']) == 1:
+            group.append(group[0]['links'][0])
+        size = sum(entry_size(e) for e in group)
+
+        room = page_size - offset % page_size
+        if room < size <= page_size:
+            layout.append({'data': [0] * room, 'links': []})
+            offset += room
+        layout += group
+        offset += size
+
+        if len(group[-1]['links']) > 1:
+            queue.extend(group[-1]['links'])
+
+    return layout
+
+
+def encode_link(link: Dict[str, Any], link_size: int = 2) -> List[int]:
+    """Encodes a node link as `link_size` little endian bytes."""
     byte_offset = link['byte_offset']
-    if not (0 <= byte_offset <= 0xffff):
-        cli.log.error('{fg_red}Error:{fg_reset} The autocorrection table is too large, a node link exceeds 64KB limit. Try reducing the autocorrection dict to fewer entries.')
+    if not (0 <= byte_offset < 1 << (8 * link_size)):
+        if link_size == 2:
+            cli.log.error('{fg_red}Error:{fg_reset} The autocorrection table is too large, a node link exceeds 64KB limit. Try reducing the autocorrection dict to fewer entries, or use --external-flash.')
+        else:
+            cli.log.error('{fg_red}Error:{fg_reset} The autocorrection table is too large, a node link exceeds %dMB limit. Try reducing the autocorrection dict to fewer entries.', (1 << (8 * link_size)) >> 20)
         sys.exit(1)
-    return [byte_offset & 255, byte_offset >> 8]
+    return [(byte_offset >> (8 * i)) & 255 for i in range(link_size)]
 
 
 def typo_len(e: Tuple[str, str]) -> int:
@@ -254,11 +329,16 @@ def to_hex(b: int) -> str:
 @cli.argument('-km', '--keymap', completer=keymap_completer, help='The keymap to build a firmware for. Ignored when a configurator export is supplied.')
 @cli.argument('-o', '--output', arg_only=True, type=normpath, help='File to write to')
 @cli.argument('-q', '--quiet', arg_only=True, action='store_true', help="Quiet mode, only output error messages")
+@cli.argument('--external-flash', arg_only=True, action='store_true', help='Write the trie to autocorrect_data.bin, to be stored in external SPI flash')
+@cli.argument('--page-size', arg_only=True, type=int, default=128, help='Cache page size the external flash image is laid out for. Default: 128')
 @cli.subcommand('Generate the autocorrection data file from a dictionary file.')
 def generate_autocorrect_data(cli):
     autocorrections = parse_file(cli.args.filename)
     trie = make_trie(autocorrections)
-    data = serialize_trie(autocorrections, trie)
+    if cli.args.external_flash:
+        data = serialize_trie(autocorrections, trie, link_size=3, page_size=cli.args.page_size)
+    else:
+        data = serialize_trie(autocorrections, trie)
 
     current_keyboard = cli.args.keyboard or cli.config.user.keyboard or cli.config.generate_autocorrect_data.keyboard
     current_keymap = cli.args.keymap or cli.config.user.keymap or cli.config.generate_autocorrect_data.keymap
@@ -283,9 +363,33 @@ def generate_autocorrect_data(cli):
     autocorrect_data_h_lines.append(f'#define AUTOCORRECT_MAX_LENGTH {len(max_typo)} // "{max_typo}"')
     autocorrect_data_h_lines.append(f'#define DICTIONARY_SIZE {len(data)}')
     autocorrect_data_h_lines.append('')
-    autocorrect_data_h_lines.append('static const uint8_t autocorrect_data[DICTIONARY_SIZE] PROGMEM = {')
-    autocorrect_data_h_lines.append(textwrap.fill('    %s' % (', '.join(map(to_hex, data))), width=100, subsequent_indent='    '))
-    autocorrect_data_h_lines.append('};')
+
+    if cli.args.external_flash:
+        if not cli.args.output:
+            cli.log.error('{fg_red}Error:{fg_reset} --external-flash needs an output file, or a keyboard and keymap, to place autocorrect_data.bin next to.')
+            sys.exit(1)
+
+        # The firmware copies each correction into a RAM buffer before typing it.
+        for typo, correction in autocorrections:
+            if len(correction) >= len(max_typo) + 10:
+                cli.log.warning('{fg_yellow}Warning:{fg_reset} Correction "{fg_cyan}%s{fg_reset}" may be truncated, corrections read from external flash are limited to %d characters.', correction, len(max_typo) + 9)
+
+        image_path = cli.args.output.with_suffix('.bin')
+        image_path.parent.mkdir(parents=True, exist_ok=True)
+        image_path.write_bytes(FLASH_IMAGE_HEADER.pack(FLASH_IMAGE_MAGIC, len(data), len(min_typo), len(max_typo), cli.args.page_size) + bytes(data))
+
+        autocorrect_data_h_lines.append(f'// The trie is stored in external flash, write {image_path.name} at AUTOCORRECT_EXTERNAL_FLASH_ADDRESS.')
+        autocorrect_data_h_lines.append('#ifndef AUTOCORRECT_EXTERNAL_FLASH')
+        autocorrect_data_h_lines.append('#    error "This dictionary was generated for external flash, define AUTOCORRECT_EXTERNAL_FLASH in config.h"')
+        autocorrect_data_h_lines.append('#endif')
+        autocorrect_data_h_lines.append(f'#define AUTOCORRECT_DATA_PAGE_SIZE {cli.args.page_size}')
+
+        if not cli.args.quiet:
+            cli.log.info('Wrote %d byte external flash image to {fg_cyan}%s{fg_reset}.', FLASH_IMAGE_HEADER.size + len(data), image_path)
+    else:
+        autocorrect_data_h_lines.append('static const uint8_t autocorrect_data[DICTIONARY_SIZE] PROGMEM = {')
+        autocorrect_data_h_lines.append(textwrap.fill('    %s' % (', '.join(map(to_hex, data))), width=100, subsequent_indent='    '))
+        autocorrect_data_h_lines.append('};')
 
     # Show the results
     dump_lines(cli.args.output, autocorrect_data_h_lines, cli.args.quiet)
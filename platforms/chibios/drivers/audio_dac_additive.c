@@ -17,7 +17,6 @@
 
 #include "audio.h"
 #include "gpio.h"
-#include <math.h>
 #include "util.h"
 
 // Need to disable GCC's "tautological-compare" warning for this file, as it causes issues when running `KEEP_INTERMEDIATES=yes`. Corresponding pop at the end of the file.
@@ -88,13 +87,36 @@ static const dacsample_t dac_buffer_trapezoid[] = {
 };
 #endif // AUDIO_DAC_SAMPLE_WAVEFORM_TRAPEZOID
 
+#if defined(AUDIO_DAC_SAMPLE_WAVEFORM_SINE)
+#    define DAC_WAVETABLE dac_buffer_sine
+#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_TRIANGLE)
+#    define DAC_WAVETABLE dac_buffer_triangle
+#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_TRAPEZOID)
+#    define DAC_WAVETABLE dac_buffer_trapezoid
+#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_SQUARE)
+#    define DAC_WAVETABLE dac_buffer_square
+#endif
+
+_Static_assert((ARRAY_SIZE(DAC_WAVETABLE) & (ARRAY_SIZE(DAC_WAVETABLE) - 1)) == 0, "AUDIO_DAC: wavetable length must be a power of two");
+
+/* Oscillator phase is a 32bit fixed-point fraction of one wavetable period, so
+ * wrapping around the table is free and the per-sample work is integer only.
+ * The 2/3 are necessary to get the correct frequencies on the DAC output (as
+ * measured with an oscilloscope), since the gpt timer runs with
+ * 3*AUDIO_DAC_SAMPLE_RATE; and the DAC callback is called twice per conversion.
+ */
+#define DAC_PHASE_PER_HZ (4294967296.0f / AUDIO_DAC_SAMPLE_RATE * 2.0f / 3.0f)
+
 static dacsample_t dac_buffer[AUDIO_DAC_BUFFER_SIZE];
 
 /* keep track of the sample position for for each frequency */
-static float dac_if[AUDIO_MAX_SIMULTANEOUS_TONES] = {0.0};
+static uint32_t dac_phase[AUDIO_MAX_SIMULTANEOUS_TONES] = {0};
 
-static float   active_tones_snapshot[AUDIO_MAX_SIMULTANEOUS_TONES] = {0};
-static uint8_t active_tones_snapshot_length                        = 0;
+/* phase increment per sample for each tone, computed once per snapshot update */
+static uint32_t active_tones_snapshot[AUDIO_MAX_SIMULTANEOUS_TONES] = {0};
+static uint8_t  active_tones_snapshot_length                        = 0;
+/* 1/active_tones_snapshot_length as a 16bit fixed-point factor */
+static uint32_t active_tones_mix_scale = 0;
 
 typedef enum {
     OUTPUT_SHOULD_START,
@@ -123,64 +145,36 @@ __attribute__((weak)) uint16_t dac_value_generate(void) {
     }
 
     /* doing additive wave synthesis over all currently playing tones = adding up
-     * sine-wave-samples for each frequency, scaled by the number of active tones
+     * wavetable-samples for each frequency, scaled by the number of active tones
      */
-    uint_fast16_t value     = 0;
-    float         frequency = 0.0f;
-
-#if defined(AUDIO_DAC_SAMPLE_WAVEFORM_SINE)
-    const size_t wavetable_length = ARRAY_SIZE(dac_buffer_sine);
-#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_TRIANGLE)
-    const size_t wavetable_length = ARRAY_SIZE(dac_buffer_triangle);
-#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_TRAPEZOID)
-    const size_t wavetable_length = ARRAY_SIZE(dac_buffer_trapezoid);
-#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_SQUARE)
-    const size_t wavetable_length = ARRAY_SIZE(dac_buffer_square);
-#endif
+    uint32_t value = 0;
 
-    for (size_t i = 0; i < active_tones_snapshot_length; i++) {
+    for (uint8_t i = 0; i < active_tones_snapshot_length; i++) {
         /* Note: a user implementation does not have to rely on the active_tones_snapshot, but
          * could directly query the active frequencies through audio_get_processed_frequency */
-        frequency = active_tones_snapshot[i];
-
-        float new_dac_if = dac_if[i];
-        new_dac_if += frequency * ((float)wavetable_length / AUDIO_DAC_SAMPLE_RATE * 2.0f / 3.0f);
-        /*Note: the 2/3 are necessary to get the correct frequencies on the
-         *      DAC output (as measured with an oscilloscope), since the gpt
-         *      timer runs with 3*AUDIO_DAC_SAMPLE_RATE; and the DAC callback
-         *      is called twice per conversion.*/
+        dac_phase[i] += active_tones_snapshot[i];
 
-        while (new_dac_if >= wavetable_length)
-            new_dac_if -= wavetable_length;
-        dac_if[i] = new_dac_if;
+        // Wavetable lookup: the top bits of the phase select the sample
+        value += DAC_WAVETABLE[((uint64_t)dac_phase[i] * ARRAY_SIZE(DAC_WAVETABLE)) >> 32];
+    }
 
-        // Wavetable generation/lookup
-        size_t dac_i = (size_t)new_dac_if;
+    return (value * active_tones_mix_scale) >> 16;
+}
 
-#if defined(AUDIO_DAC_SAMPLE_WAVEFORM_SINE)
-        value += dac_buffer_sine[dac_i] / active_tones_snapshot_length;
-#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_TRIANGLE)
-        value += dac_buffer_triangle[dac_i] / active_tones_snapshot_length;
-#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_TRAPEZOID)
-        value += dac_buffer_trapezoid[dac_i] / active_tones_snapshot_length;
-#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_SQUARE)
-        value += dac_buffer_square[dac_i] / active_tones_snapshot_length;
-#endif
-        /*
-        // SINE
-        value += dac_buffer_sine[dac_i] / active_tones_snapshot_length / 3;
-        // TRIANGLE
-        value += dac_buffer_triangle[dac_i] / active_tones_snapshot_length / 3;
-        // SQUARE
-        value += dac_buffer_square[dac_i] / active_tones_snapshot_length / 3;
-        //NOTE: combination of these three wave-forms is more exemplary - and doesn't sound particularly good :-P
-        */
-
-        // STAIRS (mostly usefully as test-pattern)
-        // value_avg = dac_buffer_staircase[dac_i] / active_tones_snapshot_length;
+/* Take a fresh snapshot of the active tones, converting each frequency to a
+ * phase increment so dac_value_generate does not need any float math.
+ */
+static void dac_update_snapshot(void) {
+    uint8_t active_tones         = MIN(AUDIO_MAX_SIMULTANEOUS_TONES, audio_get_number_of_active_tones());
+    active_tones_snapshot_length = 0;
+    for (uint8_t i = 0; i < active_tones; i++) {
+        float freq = audio_get_processed_frequency(i);
+        if (freq > 0) { // disregard 'rest' notes, with valid frequency 0.0f; which would only lower the resulting waveform volume during the additive synthesis step
+            float increment                                       = freq * DAC_PHASE_PER_HZ;
+            active_tones_snapshot[active_tones_snapshot_length++] = increment < 4294967295.0f ? (uint32_t)increment : UINT32_MAX;
+        }
     }
-
-    return value;
+    active_tones_mix_scale = active_tones_snapshot_length ? 65536U / active_tones_snapshot_length : 0;
 }
 
 /**
@@ -236,16 +230,8 @@ static void dac_end(DACDriver *dacp) {
         }
 
         if ((OUTPUT_SHOULD_START == state) || (OUTPUT_REACHED_ZERO_BEFORE_OFF == state) || (OUTPUT_REACHED_ZERO_BEFORE_TONE_CHANGE == state)) {
-            uint8_t active_tones         = MIN(AUDIO_MAX_SIMULTANEOUS_TONES, audio_get_number_of_active_tones());
-            active_tones_snapshot_length = 0;
-            // update the snapshot - once, and only on occasion that something changed;
-            // -> saves cpu cycles (?)
-            for (uint8_t i = 0; i < active_tones; i++) {
-                float freq = audio_get_processed_frequency(i);
-                if (freq > 0) { // disregard 'rest' notes, with valid frequency 0.0f; which would only lower the resulting waveform volume during the additive synthesis step
-                    active_tones_snapshot[active_tones_snapshot_length++] = freq;
-                }
-            }
+            // update the snapshot - once, and only on occasion that something changed
+            dac_update_snapshot();
 
             if ((0 == active_tones_snapshot_length) && (OUTPUT_REACHED_ZERO_BEFORE_OFF == state)) {
                 state = OUTPUT_OFF;
@@ -358,10 +344,11 @@ void audio_driver_start(void) {
     gptStartContinuous(&GPTD6, 2U);
 
     for (uint8_t i = 0; i < AUDIO_MAX_SIMULTANEOUS_TONES; i++) {
-        dac_if[i]                = 0.0f;
-        active_tones_snapshot[i] = 0.0f;
+        dac_phase[i]             = 0;
+        active_tones_snapshot[i] = 0;
     }
     active_tones_snapshot_length = 0;
+    active_tones_mix_scale       = 0;
     state                        = OUTPUT_SHOULD_START;
 }
 
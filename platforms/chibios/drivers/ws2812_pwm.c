@@ -290,6 +290,39 @@ typedef uint8_t ws2812_buffer_t;
 
 static ws2812_buffer_t ws2812_frame_buffer[WS2812_BIT_N + 1]; /**< Buffer for a frame */
 
+/**
+ * @brief   Duty cycles for the four bits of a nibble, most significant bit first
+ *
+ * Colour bytes are written into the frame buffer a nibble at a time from this table instead of testing each bit.
+ */
+#define WS2812_DUTYCYCLE_BIT(n, bit) ((((n) >> (bit)) & 1) ? WS2812_DUTYCYCLE_1 : WS2812_DUTYCYCLE_0)
+#define WS2812_DUTYCYCLE_NIBBLE(n) \
+    { WS2812_DUTYCYCLE_BIT(n, 3), WS2812_DUTYCYCLE_BIT(n, 2), WS2812_DUTYCYCLE_BIT(n, 1), WS2812_DUTYCYCLE_BIT(n, 0) }
+
+static const ws2812_buffer_t ws2812_nibble_duty[16][4] = {
+    WS2812_DUTYCYCLE_NIBBLE(0x0), WS2812_DUTYCYCLE_NIBBLE(0x1), WS2812_DUTYCYCLE_NIBBLE(0x2), WS2812_DUTYCYCLE_NIBBLE(0x3), //
+    WS2812_DUTYCYCLE_NIBBLE(0x4), WS2812_DUTYCYCLE_NIBBLE(0x5), WS2812_DUTYCYCLE_NIBBLE(0x6), WS2812_DUTYCYCLE_NIBBLE(0x7), //
+    WS2812_DUTYCYCLE_NIBBLE(0x8), WS2812_DUTYCYCLE_NIBBLE(0x9), WS2812_DUTYCYCLE_NIBBLE(0xA), WS2812_DUTYCYCLE_NIBBLE(0xB), //
+    WS2812_DUTYCYCLE_NIBBLE(0xC), WS2812_DUTYCYCLE_NIBBLE(0xD), WS2812_DUTYCYCLE_NIBBLE(0xE), WS2812_DUTYCYCLE_NIBBLE(0xF), //
+};
+
+/**
+ * @brief   Write one colour byte into the frame buffer
+ *
+ * @param[in] index:                Frame buffer index of the byte's most significant bit
+ * @param[in] data:                 The colour value
+ */
+static inline void ws2812_write_byte(uint32_t index, uint8_t data) {
+    const ws2812_buffer_t* high = ws2812_nibble_duty[data >> 4];
+    const ws2812_buffer_t* low  = ws2812_nibble_duty[data & 0x0F];
+    ws2812_buffer_t*       dest = &ws2812_frame_buffer[index];
+
+    for (uint8_t i = 0; i < 4; i++) {
+        dest[i]     = high[i];
+        dest[i + 4] = low[i];
+    }
+}
+
 /* --- PUBLIC FUNCTIONS ----------------------------------------------------- */
 /*
  * Gedanke: Double-buffer type transactions: double buffer transfers using two memory pointers for
@@ -357,22 +390,18 @@ void ws2812_init(void) {
 
 void ws2812_write_led(uint16_t led_number, uint8_t r, uint8_t g, uint8_t b) {
     // Write color to frame buffer
-    for (uint8_t bit = 0; bit < 8; bit++) {
-        ws2812_frame_buffer[WS2812_RED_BIT(led_number, bit)]   = ((r >> bit) & 0x01) ? WS2812_DUTYCYCLE_1 : WS2812_DUTYCYCLE_0;
-        ws2812_frame_buffer[WS2812_GREEN_BIT(led_number, bit)] = ((g >> bit) & 0x01) ? WS2812_DUTYCYCLE_1 : WS2812_DUTYCYCLE_0;
-        ws2812_frame_buffer[WS2812_BLUE_BIT(led_number, bit)]  = ((b >> bit) & 0x01) ? WS2812_DUTYCYCLE_1 : WS2812_DUTYCYCLE_0;
-    }
+    ws2812_write_byte(WS2812_RED_BIT(led_number, 7), r);
+    ws2812_write_byte(WS2812_GREEN_BIT(led_number, 7), g);
+    ws2812_write_byte(WS2812_BLUE_BIT(led_number, 7), b);
 }
 void ws2812_write_led_rgbw(uint16_t led_number, uint8_t r, uint8_t g, uint8_t b, uint8_t w) {
     // Write color to frame buffer
-    for (uint8_t bit = 0; bit < 8; bit++) {
-        ws2812_frame_buffer[WS2812_RED_BIT(led_number, bit)]   = ((r >> bit) & 0x01) ? WS2812_DUTYCYCLE_1 : WS2812_DUTYCYCLE_0;
-        ws2812_frame_buffer[WS2812_GREEN_BIT(led_number, bit)] = ((g >> bit) & 0x01) ? WS2812_DUTYCYCLE_1 : WS2812_DUTYCYCLE_0;
-        ws2812_frame_buffer[WS2812_BLUE_BIT(led_number, bit)]  = ((b >> bit) & 0x01) ? WS2812_DUTYCYCLE_1 : WS2812_DUTYCYCLE_0;
+    ws2812_write_byte(WS2812_RED_BIT(led_number, 7), r);
+    ws2812_write_byte(WS2812_GREEN_BIT(led_number, 7), g);
+    ws2812_write_byte(WS2812_BLUE_BIT(led_number, 7), b);
 #ifdef RGBW
-        ws2812_frame_buffer[WS2812_WHITE_BIT(led_number, bit)] = ((w >> bit) & 0x01) ? WS2812_DUTYCYCLE_1 : WS2812_DUTYCYCLE_0;
+    ws2812_write_byte(WS2812_WHITE_BIT(led_number, 7), w);
 #endif
-    }
 }
 
 // Setleds for standard RGB
@@ -85,55 +85,74 @@
 #define DATA_SIZE (BYTES_FOR_LED * WS2812_LED_COUNT)
 #define RESET_SIZE (1000 * WS2812_TRST_US / (2 * WS2812_TIMING))
 #define PREAMBLE_SIZE 4
+#define TXBUF_SIZE (PREAMBLE_SIZE + DATA_SIZE + RESET_SIZE)
 
-static uint8_t txbuf[PREAMBLE_SIZE + DATA_SIZE + RESET_SIZE] = {0};
+// Encode the next frame while the previous one is still being sent
+#ifdef WS2812_SPI_DOUBLE_BUFFER
+#    if defined(WS2812_SPI_USE_CIRCULAR_BUFFER) || defined(WS2812_SPI_SYNC)
+#        error "WS2812_SPI_DOUBLE_BUFFER cannot be used together with WS2812_SPI_USE_CIRCULAR_BUFFER or WS2812_SPI_SYNC"
+#    endif
+#    define TXBUF_COUNT 2
+#else
+#    define TXBUF_COUNT 1
+#endif
+
+static uint8_t txbuf[TXBUF_COUNT][TXBUF_SIZE] = {0};
+
+#ifdef WS2812_SPI_DOUBLE_BUFFER
+static uint8_t       txbuf_back = 0;
+static volatile bool txbuf_busy = false;
+
+static void ws2812_spi_complete_cb(SPIDriver* spip) {
+    txbuf_busy = false;
+}
+#endif
 
 /*
  * As the trick here is to use the SPI to send a huge pattern of 0 and 1 to
- * the ws2812b protocol, we use this helper function to translate bytes into
- * 0s and 1s for the LED (with the appropriate timing).
+ * the ws2812b protocol, each pair of data bits becomes one SPI byte with the
+ * appropriate timing (0b1110 for a one, 0b1000 for a zero). A nibble therefore
+ * maps onto two SPI bytes, which are looked up rather than built bit by bit.
  */
-static uint8_t get_protocol_eq(uint8_t data, int pos) {
-    uint8_t eq = 0;
-    if (data & (1 << (2 * (3 - pos))))
-        eq = 0b1110;
-    else
-        eq = 0b1000;
-    if (data & (2 << (2 * (3 - pos))))
-        eq += 0b11100000;
-    else
-        eq += 0b10000000;
-    return eq;
+#define WS2812_SPI_BIT(n, bit) ((((n) >> (bit)) & 1) ? 0b1110 : 0b1000)
+#define WS2812_SPI_NIBBLE(n) \
+    { (WS2812_SPI_BIT(n, 3) << 4) | WS2812_SPI_BIT(n, 2), (WS2812_SPI_BIT(n, 1) << 4) | WS2812_SPI_BIT(n, 0) }
+
+static const uint8_t ws2812_spi_nibble_lut[16][2] = {
+    WS2812_SPI_NIBBLE(0x0), WS2812_SPI_NIBBLE(0x1), WS2812_SPI_NIBBLE(0x2), WS2812_SPI_NIBBLE(0x3), //
+    WS2812_SPI_NIBBLE(0x4), WS2812_SPI_NIBBLE(0x5), WS2812_SPI_NIBBLE(0x6), WS2812_SPI_NIBBLE(0x7), //
+    WS2812_SPI_NIBBLE(0x8), WS2812_SPI_NIBBLE(0x9), WS2812_SPI_NIBBLE(0xA), WS2812_SPI_NIBBLE(0xB), //
+    WS2812_SPI_NIBBLE(0xC), WS2812_SPI_NIBBLE(0xD), WS2812_SPI_NIBBLE(0xE), WS2812_SPI_NIBBLE(0xF), //
+};
+
+static inline void set_led_byte(uint8_t* dest, uint8_t data) {
+    const uint8_t* high = ws2812_spi_nibble_lut[data >> 4];
+    const uint8_t* low  = ws2812_spi_nibble_lut[data & 0x0F];
+
+    dest[0] = high[0];
+    dest[1] = high[1];
+    dest[2] = low[0];
+    dest[3] = low[1];
 }
 
-static void set_led_color_rgb(rgb_led_t color, int pos) {
-    uint8_t* tx_start = &txbuf[PREAMBLE_SIZE];
+static void set_led_color_rgb(uint8_t* tx_start, rgb_led_t color, int pos) {
+    uint8_t* led = &tx_start[BYTES_FOR_LED * pos];
 
 #if (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_GRB)
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + j] = get_protocol_eq(color.g, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE + j] = get_protocol_eq(color.r, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE * 2 + j] = get_protocol_eq(color.b, j);
+    set_led_byte(led, color.g);
+    set_led_byte(led + BYTES_FOR_LED_BYTE, color.r);
+    set_led_byte(led + BYTES_FOR_LED_BYTE * 2, color.b);
 #elif (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_RGB)
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + j] = get_protocol_eq(color.r, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE + j] = get_protocol_eq(color.g, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE * 2 + j] = get_protocol_eq(color.b, j);
+    set_led_byte(led, color.r);
+    set_led_byte(led + BYTES_FOR_LED_BYTE, color.g);
+    set_led_byte(led + BYTES_FOR_LED_BYTE * 2, color.b);
 #elif (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_BGR)
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + j] = get_protocol_eq(color.b, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE + j] = get_protocol_eq(color.g, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE * 2 + j] = get_protocol_eq(color.r, j);
+    set_led_byte(led, color.b);
+    set_led_byte(led + BYTES_FOR_LED_BYTE, color.g);
+    set_led_byte(led + BYTES_FOR_LED_BYTE * 2, color.r);
 #endif
 #ifdef RGBW
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE * 4 + j] = get_protocol_eq(color.w, j);
+    set_led_byte(led + BYTES_FOR_LED_BYTE * 3, color.w);
 #endif
 }
 
@@ -151,7 +170,11 @@ void ws2812_init(void) {
 #    if SPI_SUPPORTS_CIRCULAR == TRUE
         WS2812_SPI_BUFFER_MODE,
 #    endif
+#    ifdef WS2812_SPI_DOUBLE_BUFFER
+        ws2812_spi_complete_cb, // end_cb
+#    else
         NULL, // end_cb
+#    endif
         PAL_PORT(WS2812_DI_PIN),
         PAL_PAD(WS2812_DI_PIN),
 #    if defined(WB32F3G71xx) || defined(WB32FQ95xx)
@@ -170,7 +193,11 @@ void ws2812_init(void) {
 #    if SPI_SUPPORTS_SLAVE_MODE == TRUE
         false,
 #    endif
+#    ifdef WS2812_SPI_DOUBLE_BUFFER
+        ws2812_spi_complete_cb, // data_cb
+#    else
         NULL, // data_cb
+#    endif
         NULL, // error_cb
         PAL_PORT(WS2812_DI_PIN),
         PAL_PAD(WS2812_DI_PIN),
@@ -183,7 +210,7 @@ void ws2812_init(void) {
     spiStart(&WS2812_SPI_DRIVER, &spicfg); /* Setup transfer parameters.       */
     spiSelect(&WS2812_SPI_DRIVER);         /* Slave Select assertion.          */
 #ifdef WS2812_SPI_USE_CIRCULAR_BUFFER
-    spiStartSend(&WS2812_SPI_DRIVER, ARRAY_SIZE(txbuf), txbuf);
+    spiStartSend(&WS2812_SPI_DRIVER, TXBUF_SIZE, txbuf[0]);
 #endif
 }
 
@@ -194,17 +221,30 @@ void ws2812_setleds(rgb_led_t* ledarray, uint16_t leds) {
         s_init = true;
     }
 
-    for (uint8_t i = 0; i < leds; i++) {
-        set_led_color_rgb(ledarray[i], i);
+#ifdef WS2812_SPI_DOUBLE_BUFFER
+    uint8_t* tx = txbuf[txbuf_back];
+#else
+    uint8_t* tx = txbuf[0];
+#endif
+
+    for (uint16_t i = 0; i < leds; i++) {
+        set_led_color_rgb(&tx[PREAMBLE_SIZE], ledarray[i], i);
     }
 
     // Send async - each led takes ~0.03ms, 50 leds ~1.5ms, animations flushing faster than send will cause issues.
     // Instead spiSend can be used to send synchronously (or the thread logic can be added back).
 #ifndef WS2812_SPI_USE_CIRCULAR_BUFFER
 #    ifdef WS2812_SPI_SYNC
-    spiSend(&WS2812_SPI_DRIVER, ARRAY_SIZE(txbuf), txbuf);
+    spiSend(&WS2812_SPI_DRIVER, TXBUF_SIZE, tx);
 #    else
-    spiStartSend(&WS2812_SPI_DRIVER, ARRAY_SIZE(txbuf), txbuf);
+#        ifdef WS2812_SPI_DOUBLE_BUFFER
+    // The frame was encoded while the previous one was still going out, only wait for the hand-over
+    while (txbuf_busy) {
+    }
+    txbuf_busy = true;
+    txbuf_back ^= 1;
+#        endif
+    spiStartSend(&WS2812_SPI_DRIVER, TXBUF_SIZE, tx);
 #    endif
 #endif
 }
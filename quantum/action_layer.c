@@ -316,6 +316,54 @@ action_t store_or_get_action(bool pressed, keypos_t key) {
 #endif
 }
 
+#if defined(LAYER_TRANSPARENCY_MASK) && !defined(NO_ACTION_LAYER)
+/** \brief Layers on which each matrix position is not transparent
+ *
+ * Built from the keymap on the first lookup after layer_transparency_mask_invalidate()
+ */
+static layer_state_t layer_transparency_mask[MATRIX_ROWS][MATRIX_COLS];
+static bool          layer_transparency_mask_valid = false;
+
+/** \brief Invalidate layer transparency mask
+ *
+ * Forces the masks to be rebuilt from the keymap on the next lookup
+ */
+void layer_transparency_mask_invalidate(void) {
+    layer_transparency_mask_valid = false;
+}
+
+/** \brief Update layer transparency mask
+ *
+ * Refreshes the mask bit of one key on one layer, without rebuilding the whole mask
+ */
+void layer_transparency_mask_update(uint8_t layer, keypos_t key) {
+    if (!layer_transparency_mask_valid || layer >= MAX_LAYER || key.row >= MATRIX_ROWS || key.col >= MATRIX_COLS) {
+        return;
+    }
+    if (action_for_key(layer, key).code != ACTION_TRANSPARENT) {
+        layer_transparency_mask[key.row][key.col] |= (layer_state_t)1 << layer;
+    } else {
+        layer_transparency_mask[key.row][key.col] &= ~((layer_state_t)1 << layer);
+    }
+}
+
+static void layer_transparency_mask_build(void) {
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            keypos_t      key  = {.row = row, .col = col};
+            layer_state_t mask = 0;
+            for (uint8_t layer = 0; layer < MAX_LAYER; layer++) {
+                if (action_for_key(layer, key).code != ACTION_TRANSPARENT) {
+                    mask |= (layer_state_t)1 << layer;
+                }
+            }
+            layer_transparency_mask[row][col] = mask;
+        }
+    }
+    layer_transparency_mask_valid = true;
+}
+#endif
+
 /** \brief Layer switch get layer
  *
  * Gets the layer based on key info
@@ -326,6 +374,16 @@ uint8_t layer_switch_get_layer(keypos_t key) {
     action.code = ACTION_TRANSPARENT;
 
     layer_state_t layers = layer_state | default_layer_state;
+#    ifdef LAYER_TRANSPARENCY_MASK
+    if (key.row < MATRIX_ROWS && key.col < MATRIX_COLS) {
+        if (!layer_transparency_mask_valid) {
+            layer_transparency_mask_build();
+        }
+        layers &= layer_transparency_mask[key.row][key.col];
+        /* fall back to layer 0 */
+        return layers ? get_highest_layer(layers) : 0;
+    }
+#    endif
     /* check top layer first */
     for (int8_t i = MAX_LAYER - 1; i >= 0; i--) {
         if (layers & ((layer_state_t)1 << i)) {
@@ -168,3 +168,13 @@ uint8_t layer_switch_get_layer(keypos_t key);
 
 /* return action depending on current layer status */
 action_t layer_switch_get_action(keypos_t key);
+
+#if defined(LAYER_TRANSPARENCY_MASK) && !defined(NO_ACTION_LAYER)
+/* rebuild the per-key non-transparent layer masks on the next lookup, call after changing the keymap */
+void layer_transparency_mask_invalidate(void);
+/* refresh the mask of a single key on a single layer after its keycode changed */
+void layer_transparency_mask_update(uint8_t layer, keypos_t key);
+#else
+#    define layer_transparency_mask_invalidate()
+#    define layer_transparency_mask_update(layer, key) ((void)(layer), (void)(key))
+#endif
@@ -5,6 +5,7 @@
 #include "action_layer.h"
 #include "action_tapping.h"
 #include "keycode.h"
+#include "matrix.h"
 #include "timer.h"
 
 #ifndef NO_ACTION_TAPPING
@@ -15,6 +16,10 @@
 #        error "IGNORE_MOD_TAP_INTERRUPT is no longer necessary as it is now the default behavior of mod-tap keys. Please remove it from your config."
 #    endif
 
+#    if WAITING_BUFFER_SIZE < 2 || WAITING_BUFFER_SIZE > 255
+#        error "WAITING_BUFFER_SIZE must be between 2 and 255"
+#    endif
+
 #    ifndef COMBO_ENABLE
 #        define IS_TAPPING_RECORD(r) (KEYEQ(tapping_key.event.key, (r->event.key)))
 #    else
@@ -64,8 +69,15 @@ static keyrecord_t waiting_buffer[WAITING_BUFFER_SIZE] = {};
 static uint8_t     waiting_buffer_head                 = 0;
 static uint8_t     waiting_buffer_tail                 = 0;
 
+/* Matrix keys with a press ([true]) or release ([false]) waiting in the buffer */
+static matrix_row_t waiting_buffer_pending[2][MATRIX_ROWS] = {};
+
+static uint16_t waiting_buffer_overflows = 0;
+static uint8_t  waiting_buffer_peak      = 0;
+
 static bool process_tapping(keyrecord_t *record);
 static bool waiting_buffer_enq(keyrecord_t record);
+static void waiting_buffer_deq(void);
 static void waiting_buffer_clear(void);
 static bool waiting_buffer_typed(keyevent_t event);
 static bool waiting_buffer_has_anykey_pressed(void);
@@ -87,7 +99,8 @@ void action_tapping_process(keyrecord_t record) {
     } else {
         if (!waiting_buffer_enq(record)) {
             // clear all in case of overflow.
-            ac_dprintf("OVERFLOW: CLEAR ALL STATES\n");
+            waiting_buffer_overflows++;
+            ac_dprintf("OVERFLOW: CLEAR ALL STATES (%u overflows)\n", waiting_buffer_overflows);
             clear_keyboard();
             waiting_buffer_clear();
             tapping_key = (keyrecord_t){0};
@@ -98,11 +111,12 @@ void action_tapping_process(keyrecord_t record) {
     if (IS_EVENT(record.event) && waiting_buffer_head != waiting_buffer_tail) {
         ac_dprintf("---- action_exec: process waiting_buffer -----\n");
     }
-    for (; waiting_buffer_tail != waiting_buffer_head; waiting_buffer_tail = (waiting_buffer_tail + 1) % WAITING_BUFFER_SIZE) {
+    while (waiting_buffer_tail != waiting_buffer_head) {
         if (process_tapping(&waiting_buffer[waiting_buffer_tail])) {
             ac_dprintf("processed: waiting_buffer[%u] =", waiting_buffer_tail);
             debug_record(waiting_buffer[waiting_buffer_tail]);
             ac_dprintf("\n\n");
+            waiting_buffer_deq();
         } else {
             break;
         }
@@ -432,9 +446,48 @@ bool process_tapping(keyrecord_t *keyp) {
     }
 }
 
+/** \brief Action tapping overflow count
+ *
+ * Number of times the waiting buffer overflowed and all tapping state was cleared
+ */
+uint16_t action_tapping_overflow_count(void) {
+    return waiting_buffer_overflows;
+}
+
+/** \brief Action tapping waiting buffer peak
+ *
+ * Largest number of events held in the waiting buffer at once
+ */
+uint8_t action_tapping_waiting_buffer_peak(void) {
+    return waiting_buffer_peak;
+}
+
+/** \brief Action tapping reset stats
+ *
+ * Clears the overflow count and the waiting buffer peak
+ */
+void action_tapping_reset_stats(void) {
+    waiting_buffer_overflows = 0;
+    waiting_buffer_peak      = 0;
+}
+
+/** \brief Waiting buffer pending bit
+ *
+ * Marks whether an event of the same direction as `event` is waiting for its key
+ */
+static void waiting_buffer_set_pending(keyevent_t event, bool pending) {
+    if (event.key.row < MATRIX_ROWS && event.key.col < MATRIX_COLS) {
+        if (pending) {
+            waiting_buffer_pending[event.pressed][event.key.row] |= (matrix_row_t)1 << event.key.col;
+        } else {
+            waiting_buffer_pending[event.pressed][event.key.row] &= ~((matrix_row_t)1 << event.key.col);
+        }
+    }
+}
+
 /** \brief Waiting buffer enq
  *
- * FIXME: Needs docs
+ * Appends a record, returns false if the buffer is full
  */
 bool waiting_buffer_enq(keyrecord_t record) {
     if (IS_NOEVENT(record.event)) {
@@ -448,34 +501,73 @@ bool waiting_buffer_enq(keyrecord_t record) {
 
     waiting_buffer[waiting_buffer_head] = record;
     waiting_buffer_head                 = (waiting_buffer_head + 1) % WAITING_BUFFER_SIZE;
+    waiting_buffer_set_pending(record.event, true);
+
+    uint8_t count = (waiting_buffer_head + WAITING_BUFFER_SIZE - waiting_buffer_tail) % WAITING_BUFFER_SIZE;
+    if (count > waiting_buffer_peak) {
+        waiting_buffer_peak = count;
+    }
 
     ac_dprintf("waiting_buffer_enq: ");
     debug_waiting_buffer();
     return true;
 }
 
+/** \brief Waiting buffer deq
+ *
+ * Drops the oldest record, keeping the pending bit of its key set if the same key
+ * has another event of the same direction further down the buffer
+ */
+void waiting_buffer_deq(void) {
+    keyevent_t event    = waiting_buffer[waiting_buffer_tail].event;
+    waiting_buffer_tail = (waiting_buffer_tail + 1) % WAITING_BUFFER_SIZE;
+
+    for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i = (i + 1) % WAITING_BUFFER_SIZE) {
+        if (KEYEQ(event.key, waiting_buffer[i].event.key) && event.pressed == waiting_buffer[i].event.pressed) {
+            return;
+        }
+    }
+    waiting_buffer_set_pending(event, false);
+}
+
 /** \brief Waiting buffer clear
  *
- * FIXME: Needs docs
+ * Drops all records
  */
 void waiting_buffer_clear(void) {
     waiting_buffer_head = 0;
     waiting_buffer_tail = 0;
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        waiting_buffer_pending[false][row] = 0;
+        waiting_buffer_pending[true][row]  = 0;
+    }
 }
 
-/** \brief Waiting buffer typed
+/** \brief Waiting buffer has pending
  *
- * FIXME: Needs docs
+ * Whether the buffer holds an event for `key` in the given direction. Constant time for
+ * matrix keys, other key positions (combos, encoders) fall back to scanning the buffer
  */
-bool waiting_buffer_typed(keyevent_t event) {
+static bool waiting_buffer_has_pending(keypos_t key, bool pressed) {
+    if (key.row < MATRIX_ROWS && key.col < MATRIX_COLS) {
+        return waiting_buffer_pending[pressed][key.row] & ((matrix_row_t)1 << key.col);
+    }
     for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i = (i + 1) % WAITING_BUFFER_SIZE) {
-        if (KEYEQ(event.key, waiting_buffer[i].event.key) && event.pressed != waiting_buffer[i].event.pressed) {
+        if (KEYEQ(key, waiting_buffer[i].event.key) && pressed == waiting_buffer[i].event.pressed) {
             return true;
         }
     }
     return false;
 }
 
+/** \brief Waiting buffer typed
+ *
+ * Whether the opposite event of `event` (e.g. the release of a press) is waiting in the buffer
+ */
+bool waiting_buffer_typed(keyevent_t event) {
+    return waiting_buffer_has_pending(event.key, !event.pressed);
+}
+
 /** \brief Waiting buffer has anykey pressed
  *
  * FIXME: Needs docs
@@ -495,7 +587,8 @@ void waiting_buffer_scan_tap(void) {
     // early return if:
     // - tapping already is settled
     // - invalid state: tapping_key released && tap.count == 0
-    if ((tapping_key.tap.count > 0) || !tapping_key.event.pressed) {
+    // - the tapping key has not been released yet
+    if ((tapping_key.tap.count > 0) || !tapping_key.event.pressed || !waiting_buffer_has_pending(tapping_key.event.key, false)) {
         return;
     }
 
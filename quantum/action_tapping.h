@@ -32,12 +32,22 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #    define TAPPING_TOGGLE 5
 #endif
 
-#define WAITING_BUFFER_SIZE 8
+/* events held back while a tap-hold key is undecided, one slot is always kept free */
+#ifndef WAITING_BUFFER_SIZE
+#    define WAITING_BUFFER_SIZE 8
+#endif
 
 #ifndef NO_ACTION_TAPPING
 uint16_t get_record_keycode(keyrecord_t *record, bool update_layer_cache);
 uint16_t get_event_keycode(keyevent_t event, bool update_layer_cache);
 void     action_tapping_process(keyrecord_t record);
+
+/* number of times the waiting buffer overflowed and all tapping state was cleared */
+uint16_t action_tapping_overflow_count(void);
+/* largest number of events held in the waiting buffer at once */
+uint8_t action_tapping_waiting_buffer_peak(void);
+/* clears the overflow count and the peak */
+void action_tapping_reset_stats(void);
 #endif
 
 uint16_t get_tapping_term(uint16_t keycode, keyrecord_t *record);
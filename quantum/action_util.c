@@ -31,6 +31,9 @@ static uint8_t weak_mods = 0;
 static uint8_t weak_override_mods = 0;
 static uint8_t suppressed_mods    = 0;
 #endif
+#if defined(UNICODE_COMMON_ENABLE) && defined(UNICODEMAP_ASYNC)
+static uint8_t unicode_held_back_mods = 0;
+#endif
 
 // TODO: pointer variable is not needed
 // report_keyboard_t keyboard_report = {};
@@ -279,6 +282,10 @@ static uint8_t get_mods_for_report(void) {
     mods |= weak_override_mods;
 #endif
 
+#if defined(UNICODE_COMMON_ENABLE) && defined(UNICODEMAP_ASYNC)
+    mods &= ~unicode_held_back_mods;
+#endif
+
     return mods;
 }
 
@@ -424,6 +431,14 @@ void clear_suppressed_override_mods(void) {
 }
 #endif
 
+#if defined(UNICODE_COMMON_ENABLE) && defined(UNICODEMAP_ASYNC)
+/** \brief set mods kept out of reports while background Unicode input has them held back. DO not call this manually
+ */
+void set_unicode_held_back_mods(uint8_t mods) {
+    unicode_held_back_mods = mods;
+}
+#endif
+
 #ifndef NO_ACTION_ONESHOT
 /** \brief get oneshot mods
  *
@@ -59,6 +59,11 @@ void    del_weak_mods(uint8_t mods);
 void    set_weak_mods(uint8_t mods);
 void    clear_weak_mods(void);
 
+#if defined(UNICODE_COMMON_ENABLE) && defined(UNICODEMAP_ASYNC)
+/* modifiers held back by background Unicode input */
+void set_unicode_held_back_mods(uint8_t mods);
+#endif
+
 /* oneshot modifier */
 uint8_t get_oneshot_mods(void);
 void    add_oneshot_mods(uint8_t mods);
@@ -20,6 +20,14 @@
 #include "debug.h"
 #include "wait.h"
 #include "util.h"
+#include "progmem.h"
+#ifdef AUDIO_FLASH_SONGS
+#    ifndef FLASH_SPI
+#        error "AUDIO_FLASH_SONGS requires FLASH_DRIVER = spi"
+#    endif
+#    include "atomic_util.h"
+#    include "flash_spi.h"
+#endif
 
 /* audio system:
  *
@@ -90,6 +98,38 @@ uint16_t current_note                 = 0;             // index into the array a
 bool     note_resting                 = false;         // if a short pause was introduced between two notes with the same frequency while playing a melody
 uint16_t last_timestamp               = 0;
 
+typedef enum {
+    MELODY_FORMAT_FLOAT,   // SONG array in RAM, at notes_pointer
+    MELODY_FORMAT_COMPACT, // COMPACT_SONG array in PROGMEM, at compact_notes_pointer
+#ifdef AUDIO_FLASH_SONGS
+    MELODY_FORMAT_FLASH, // COMPACT_SONG data in external flash, at flash_song_address
+#endif
+} melody_format_t;
+
+static melody_format_t melody_format = MELODY_FORMAT_FLOAT;
+static const uint8_t  *compact_notes_pointer;
+static float           melody_current_pitch; // pitch of the note at current_note, kept so the next note can be compared against it without reading it back
+
+#ifdef AUDIO_FLASH_SONGS
+#    ifndef AUDIO_FLASH_SONG_BUFFER_NOTES
+#        define AUDIO_FLASH_SONG_BUFFER_NOTES 8
+#    endif
+#    define FLASH_SONG_NO_BLOCK UINT16_MAX
+
+/* Songs in external flash are streamed through two windows of consecutive
+ * notes, refilled from audio_task. audio_update_state runs from a timer or DMA
+ * interrupt on most drivers, where a SPI transfer is not possible, so it only
+ * ever reads notes that are already buffered.
+ */
+typedef struct {
+    volatile uint16_t first; // index of the first note held, FLASH_SONG_NO_BLOCK while being (re)loaded
+    uint8_t           notes[AUDIO_FLASH_SONG_BUFFER_NOTES][2];
+} flash_song_window_t;
+
+static flash_song_window_t flash_song_windows[2] = {{.first = FLASH_SONG_NO_BLOCK}, {.first = FLASH_SONG_NO_BLOCK}};
+static uint32_t            flash_song_address;
+#endif
+
 #ifdef AUDIO_ENABLE_TONE_MULTIPLEXING
 #    ifndef AUDIO_MAX_SIMULTANEOUS_TONES
 #        define AUDIO_MAX_SIMULTANEOUS_TONES 3
@@ -312,14 +352,97 @@ void audio_play_tone(float pitch) {
     audio_play_note(pitch, 0xffff);
 }
 
-void audio_play_melody(float (*np)[][2], uint16_t n_count, bool n_repeat) {
+static const float compact_pitch_octave8[12] PROGMEM = {NOTE_C8, NOTE_CS8, NOTE_D8, NOTE_DS8, NOTE_E8, NOTE_F8, NOTE_FS8, NOTE_G8, NOTE_GS8, NOTE_A8, NOTE_AS8, NOTE_B8};
+
+float audio_compact_pitch_to_frequency(uint8_t pitch) {
+    if (pitch == PITCH_REST || pitch > PITCH_B8) {
+        return NOTE_REST;
+    }
+    uint8_t octave = (pitch - 1) / 12;
+    uint8_t index  = (pitch - 1) % 12;
+    float   freq;
+    memcpy_P(&freq, &compact_pitch_octave8[index], sizeof(freq));
+    return freq / (1 << (8 - octave));
+}
+
+#ifdef AUDIO_FLASH_SONGS
+static void flash_song_load_block(uint16_t first) {
+    flash_song_window_t *window = &flash_song_windows[(first / AUDIO_FLASH_SONG_BUFFER_NOTES) & 1];
+    if (window->first == first) {
+        return;
+    }
+    window->first  = FLASH_SONG_NO_BLOCK;
+    uint16_t count = MIN(AUDIO_FLASH_SONG_BUFFER_NOTES, notes_count - first);
+    if (flash_read_block(flash_song_address + (uint32_t)first * 2, window->notes, count * 2) == FLASH_STATUS_SUCCESS) {
+        window->first = first;
+    }
+}
+
+static uint16_t flash_song_next_block(uint16_t first) {
+    first += AUDIO_FLASH_SONG_BUFFER_NOTES;
+    return first < notes_count ? first : 0;
+}
+
+void audio_task(void) {
+    if (!playing_melody || melody_format != MELODY_FORMAT_FLASH) {
+        return;
+    }
+
+    uint16_t note;
+    ATOMIC_BLOCK_FORCEON {
+        note = current_note;
+    }
+
+    // make sure the block holding the next note is loaded first, then prefetch
+    // the one after it unless both map onto the same window
+    uint16_t next  = note + 1 < notes_count ? note + 1 : 0;
+    uint16_t block = next - next % AUDIO_FLASH_SONG_BUFFER_NOTES;
+    uint16_t after = flash_song_next_block(block);
+    flash_song_load_block(block);
+    if ((after != 0 || notes_repeat) && ((after / AUDIO_FLASH_SONG_BUFFER_NOTES) & 1) != ((block / AUDIO_FLASH_SONG_BUFFER_NOTES) & 1)) {
+        flash_song_load_block(after);
+    }
+}
+#else
+void audio_task(void) {}
+#endif
+
+/* Reads one note of the active melody; returns false if it is not available
+ * (yet), which can only happen while streaming from external flash.
+ */
+static bool melody_get_note(uint16_t index, float *pitch, uint16_t *duration) {
+    switch (melody_format) {
+        case MELODY_FORMAT_COMPACT:
+            *pitch    = audio_compact_pitch_to_frequency(pgm_read_byte(&compact_notes_pointer[index * 2]));
+            *duration = pgm_read_byte(&compact_notes_pointer[index * 2 + 1]);
+            return true;
+#ifdef AUDIO_FLASH_SONGS
+        case MELODY_FORMAT_FLASH: {
+            flash_song_window_t *window = &flash_song_windows[(index / AUDIO_FLASH_SONG_BUFFER_NOTES) & 1];
+            uint16_t             first  = window->first;
+            if (first == FLASH_SONG_NO_BLOCK || index < first || index >= first + AUDIO_FLASH_SONG_BUFFER_NOTES) {
+                return false;
+            }
+            *pitch    = audio_compact_pitch_to_frequency(window->notes[index - first][0]);
+            *duration = window->notes[index - first][1];
+            return true;
+        }
+#endif
+        default:
+            *pitch    = (*notes_pointer)[index][0];
+            *duration = (*notes_pointer)[index][1];
+            return true;
+    }
+}
+
+static bool audio_prepare_melody(uint16_t n_count) {
     if (!audio_config.enable) {
         audio_stop_all();
-        return;
+        return false;
     }
 
     if (n_count == 0) {
-        return;
+        return false;
     }
 
     if (!audio_initialized) {
@@ -329,22 +452,70 @@ void audio_play_melody(float (*np)[][2], uint16_t n_count, bool n_repeat) {
     // Cancel note if a note is playing
     if (playing_note) audio_stop_all();
 
-    playing_melody = true;
-    note_resting   = false;
+    return true;
+}
 
-    notes_pointer = np;
-    notes_count   = n_count;
-    notes_repeat  = n_repeat;
+static void audio_start_melody(uint16_t n_count, bool n_repeat) {
+    float    pitch;
+    uint16_t duration;
 
+    notes_count  = n_count;
+    notes_repeat = n_repeat;
     current_note = 0; // note in the melody-array/list at note_pointer
+    note_resting = false;
+
+    if (!melody_get_note(current_note, &pitch, &duration)) {
+        return;
+    }
+    playing_melody = true;
 
     // start first note manually, which also starts the audio_driver
     // all following/remaining notes are played by 'audio_update_state'
-    audio_play_note((*notes_pointer)[current_note][0], audio_duration_to_ms((*notes_pointer)[current_note][1]));
+    audio_play_note(pitch, audio_duration_to_ms(duration));
     last_timestamp               = timer_read();
-    melody_current_note_duration = audio_duration_to_ms((*notes_pointer)[current_note][1]);
+    melody_current_note_duration = audio_duration_to_ms(duration);
+    melody_current_pitch         = pitch;
 }
 
+void audio_play_melody(float (*np)[][2], uint16_t n_count, bool n_repeat) {
+    if (!audio_prepare_melody(n_count)) {
+        return;
+    }
+
+    melody_format = MELODY_FORMAT_FLOAT;
+    notes_pointer = np;
+    audio_start_melody(n_count, n_repeat);
+}
+
+void audio_play_compact_melody(const uint8_t *np, uint16_t n_count, bool n_repeat) {
+    if (!audio_prepare_melody(n_count)) {
+        return;
+    }
+
+    melody_format         = MELODY_FORMAT_COMPACT;
+    compact_notes_pointer = np;
+    audio_start_melody(n_count, n_repeat);
+}
+
+#ifdef AUDIO_FLASH_SONGS
+void audio_play_flash_melody(uint32_t address, uint16_t n_count, bool n_repeat) {
+    if (!audio_prepare_melody(n_count)) {
+        return;
+    }
+
+    melody_format                = MELODY_FORMAT_FLASH;
+    flash_song_address           = address;
+    flash_song_windows[0].first  = FLASH_SONG_NO_BLOCK;
+    flash_song_windows[1].first  = FLASH_SONG_NO_BLOCK;
+    notes_count                  = n_count;
+    flash_song_load_block(0);
+    if (n_count > AUDIO_FLASH_SONG_BUFFER_NOTES) {
+        flash_song_load_block(AUDIO_FLASH_SONG_BUFFER_NOTES);
+    }
+    audio_start_melody(n_count, n_repeat);
+}
+#endif
+
 float click[2][2];
 void  audio_play_click(uint16_t delay, float pitch, uint16_t duration) {
     uint16_t duration_tone  = audio_ms_to_duration(duration);
@@ -416,30 +587,35 @@ bool audio_update_state(void) {
     uint16_t current_time   = timer_read();
 
     if (playing_melody) {
+        uint16_t next_note = current_note + 1;
+        float    pitch;
+        uint16_t duration_bpm;
+
         goto_next_note = timer_elapsed(last_timestamp) >= melody_current_note_duration;
         if (goto_next_note) {
-            uint16_t delta         = timer_elapsed(last_timestamp) - melody_current_note_duration;
-            last_timestamp         = current_time;
-            uint16_t previous_note = current_note;
-            current_note++;
-            voices_timer = timer_read(); // reset to zero, for the effects added by voices.c
-
-            if (current_note >= notes_count) {
+            if (next_note >= notes_count) {
                 if (notes_repeat) {
-                    current_note = 0;
+                    next_note = 0;
                 } else {
                     audio_stop_all();
                     return false;
                 }
             }
 
-            if (!note_resting && (*notes_pointer)[previous_note][0] == (*notes_pointer)[current_note][0]) {
+            // a note streamed from external flash might not be buffered yet, hold the current one a little longer
+            goto_next_note = melody_get_note(next_note, &pitch, &duration_bpm);
+        }
+        if (goto_next_note) {
+            uint16_t delta = timer_elapsed(last_timestamp) - melody_current_note_duration;
+            last_timestamp = current_time;
+            voices_timer   = timer_read(); // reset to zero, for the effects added by voices.c
+
+            if (!note_resting && melody_current_pitch == pitch) {
                 note_resting = true;
 
                 // special handling for successive notes of the same frequency:
                 // insert a short pause to separate them audibly
                 audio_play_note(0.0f, audio_duration_to_ms(2));
-                current_note                 = previous_note;
                 melody_current_note_duration = audio_duration_to_ms(2);
 
             } else {
@@ -457,13 +633,17 @@ bool audio_update_state(void) {
 
                 // '- delta': Skip forward in the next note's length if we've over shot
                 //            the last, so the overall length of the song is the same
-                uint16_t duration = audio_duration_to_ms((*notes_pointer)[current_note][1]);
+                current_note      = next_note;
+                uint16_t duration = audio_duration_to_ms(duration_bpm);
 
                 // Skip forward past any completely missed notes
                 while (delta > duration && current_note < notes_count - 1) {
+                    if (!melody_get_note(current_note + 1, &pitch, &duration_bpm)) {
+                        break;
+                    }
                     delta -= duration;
                     current_note++;
-                    duration = audio_duration_to_ms((*notes_pointer)[current_note][1]);
+                    duration = audio_duration_to_ms(duration_bpm);
                 }
 
                 if (delta < duration) {
@@ -474,8 +654,9 @@ bool audio_update_state(void) {
                     duration = 1;
                 }
 
-                audio_play_note((*notes_pointer)[current_note][0], duration);
+                audio_play_note(pitch, duration);
                 melody_current_note_duration = duration;
+                melody_current_pitch         = pitch;
             }
         }
     }
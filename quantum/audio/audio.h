@@ -185,6 +185,38 @@ bool audio_is_playing_melody(void);
  */
 #define PLAY_LOOP(note_array) audio_play_melody(&note_array, NOTE_ARRAY_SIZE((note_array)), true)
 
+/**
+ * @brief Play a COMPACT_SONG, read note by note from PROGMEM
+ *
+ * @param[in] np pointer to the PROGMEM song data, two bytes per note
+ * @param[in] n_count number of notes
+ * @param[in] n_repeat loop the song
+ */
+void audio_play_compact_melody(const uint8_t *np, uint16_t n_count, bool n_repeat);
+
+#define COMPACT_NOTE_COUNT(x) ((uint16_t)(sizeof(x) / 2))
+
+#define PLAY_COMPACT_SONG(note_array) audio_play_compact_melody(note_array, COMPACT_NOTE_COUNT(note_array), false)
+#define PLAY_COMPACT_LOOP(note_array) audio_play_compact_melody(note_array, COMPACT_NOTE_COUNT(note_array), true)
+
+#ifdef AUDIO_FLASH_SONGS
+/**
+ * @brief Play a COMPACT_SONG stored in external SPI flash
+ *
+ * Notes are streamed through a small buffer that is refilled from audio_task.
+ *
+ * @param[in] address flash address of the first note
+ * @param[in] n_count number of notes
+ * @param[in] n_repeat loop the song
+ */
+void audio_play_flash_melody(uint32_t address, uint16_t n_count, bool n_repeat);
+#endif
+
+/**
+ * @brief Convert a PITCH_* index from a COMPACT_SONG to its frequency in Hz
+ */
+float audio_compact_pitch_to_frequency(uint8_t pitch);
+
 // Tone-Multiplexing functions
 // this feature only makes sense for hardware setups which can't do proper
 // audio-wave synthesis = have no DAC and need to use PWM for tone generation
@@ -212,6 +244,8 @@ uint16_t audio_ms_to_duration(uint16_t duration_ms);
 
 void audio_startup(void);
 
+void audio_task(void);
+
 // hardware interface
 
 // implementation in the driver_avr/arm_* respective parts
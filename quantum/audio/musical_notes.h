@@ -232,3 +232,171 @@
 #define NOTE_GF8 NOTE_FS8
 #define NOTE_AF8 NOTE_GS8
 #define NOTE_BF8 NOTE_AS8
+
+// Compact songs
+// Two bytes per note: a pitch index as defined below (0 is a rest, then one per
+// semitone starting at C0) and a duration in the same 64-parts-to-a-beat unit
+// as MUSICAL_NOTE, which therefore has to fit into a byte. Such a song takes a
+// quarter of the space of a float SONG and can stay in PROGMEM or external flash.
+// A duration outside 0..255 is a compile error rather than being truncated.
+#define COMPACT_SONG(notes...) \
+    { notes }
+#define COMPACT_NOTE(note, duration) (PITCH##note), COMPACT_DURATION(duration)
+#define COMPACT_DURATION(duration) ((uint8_t)((duration) + 0 * sizeof(char[((duration) >= 0 && (duration) <= 255) ? 1 : -1])))
+
+#define PITCH_REST 0
+#define PITCH_C0 1
+#define PITCH_CS0 2
+#define PITCH_D0 3
+#define PITCH_DS0 4
+#define PITCH_E0 5
+#define PITCH_F0 6
+#define PITCH_FS0 7
+#define PITCH_G0 8
+#define PITCH_GS0 9
+#define PITCH_A0 10
+#define PITCH_AS0 11
+#define PITCH_B0 12
+#define PITCH_C1 13
+#define PITCH_CS1 14
+#define PITCH_D1 15
+#define PITCH_DS1 16
+#define PITCH_E1 17
+#define PITCH_F1 18
+#define PITCH_FS1 19
+#define PITCH_G1 20
+#define PITCH_GS1 21
+#define PITCH_A1 22
+#define PITCH_AS1 23
+#define PITCH_B1 24
+#define PITCH_C2 25
+#define PITCH_CS2 26
+#define PITCH_D2 27
+#define PITCH_DS2 28
+#define PITCH_E2 29
+#define PITCH_F2 30
+#define PITCH_FS2 31
+#define PITCH_G2 32
+#define PITCH_GS2 33
+#define PITCH_A2 34
+#define PITCH_AS2 35
+#define PITCH_B2 36
+#define PITCH_C3 37
+#define PITCH_CS3 38
+#define PITCH_D3 39
+#define PITCH_DS3 40
+#define PITCH_E3 41
+#define PITCH_F3 42
+#define PITCH_FS3 43
+#define PITCH_G3 44
+#define PITCH_GS3 45
+#define PITCH_A3 46
+#define PITCH_AS3 47
+#define PITCH_B3 48
+#define PITCH_C4 49
+#define PITCH_CS4 50
+#define PITCH_D4 51
+#define PITCH_DS4 52
+#define PITCH_E4 53
+#define PITCH_F4 54
+#define PITCH_FS4 55
+#define PITCH_G4 56
+#define PITCH_GS4 57
+#define PITCH_A4 58
+#define PITCH_AS4 59
+#define PITCH_B4 60
+#define PITCH_C5 61
+#define PITCH_CS5 62
+#define PITCH_D5 63
+#define PITCH_DS5 64
+#define PITCH_E5 65
+#define PITCH_F5 66
+#define PITCH_FS5 67
+#define PITCH_G5 68
+#define PITCH_GS5 69
+#define PITCH_A5 70
+#define PITCH_AS5 71
+#define PITCH_B5 72
+#define PITCH_C6 73
+#define PITCH_CS6 74
+#define PITCH_D6 75
+#define PITCH_DS6 76
+#define PITCH_E6 77
+#define PITCH_F6 78
+#define PITCH_FS6 79
+#define PITCH_G6 80
+#define PITCH_GS6 81
+#define PITCH_A6 82
+#define PITCH_AS6 83
+#define PITCH_B6 84
+#define PITCH_C7 85
+#define PITCH_CS7 86
+#define PITCH_D7 87
+#define PITCH_DS7 88
+#define PITCH_E7 89
+#define PITCH_F7 90
+#define PITCH_FS7 91
+#define PITCH_G7 92
+#define PITCH_GS7 93
+#define PITCH_A7 94
+#define PITCH_AS7 95
+#define PITCH_B7 96
+#define PITCH_C8 97
+#define PITCH_CS8 98
+#define PITCH_D8 99
+#define PITCH_DS8 100
+#define PITCH_E8 101
+#define PITCH_F8 102
+#define PITCH_FS8 103
+#define PITCH_G8 104
+#define PITCH_GS8 105
+#define PITCH_A8 106
+#define PITCH_AS8 107
+#define PITCH_B8 108
+
+// Flat Aliases
+#define PITCH_DF0 PITCH_CS0
+#define PITCH_EF0 PITCH_DS0
+#define PITCH_GF0 PITCH_FS0
+#define PITCH_AF0 PITCH_GS0
+#define PITCH_BF0 PITCH_AS0
+#define PITCH_DF1 PITCH_CS1
+#define PITCH_EF1 PITCH_DS1
+#define PITCH_GF1 PITCH_FS1
+#define PITCH_AF1 PITCH_GS1
+#define PITCH_BF1 PITCH_AS1
+#define PITCH_DF2 PITCH_CS2
+#define PITCH_EF2 PITCH_DS2
+#define PITCH_GF2 PITCH_FS2
+#define PITCH_AF2 PITCH_GS2
+#define PITCH_BF2 PITCH_AS2
+#define PITCH_DF3 PITCH_CS3
+#define PITCH_EF3 PITCH_DS3
+#define PITCH_GF3 PITCH_FS3
+#define PITCH_AF3 PITCH_GS3
+#define PITCH_BF3 PITCH_AS3
+#define PITCH_DF4 PITCH_CS4
+#define PITCH_EF4 PITCH_DS4
+#define PITCH_GF4 PITCH_FS4
+#define PITCH_AF4 PITCH_GS4
+#define PITCH_BF4 PITCH_AS4
+#define PITCH_DF5 PITCH_CS5
+#define PITCH_EF5 PITCH_DS5
+#define PITCH_GF5 PITCH_FS5
+#define PITCH_AF5 PITCH_GS5
+#define PITCH_BF5 PITCH_AS5
+#define PITCH_DF6 PITCH_CS6
+#define PITCH_EF6 PITCH_DS6
+#define PITCH_GF6 PITCH_FS6
+#define PITCH_AF6 PITCH_GS6
+#define PITCH_BF6 PITCH_AS6
+#define PITCH_DF7 PITCH_CS7
+#define PITCH_EF7 PITCH_DS7
+#define PITCH_GF7 PITCH_FS7
+#define PITCH_AF7 PITCH_GS7
+#define PITCH_BF7 PITCH_AS7
+#define PITCH_DF8 PITCH_CS8
+#define PITCH_EF8 PITCH_DS8
+#define PITCH_GF8 PITCH_FS8
+#define PITCH_AF8 PITCH_GS8
+#define PITCH_BF8 PITCH_AS8
@@ -177,11 +177,11 @@ void backlight_level(uint8_t level) {
 }
 
 uint8_t eeconfig_read_backlight(void) {
-    return eeprom_read_byte(EECONFIG_BACKLIGHT);
+    return eeconfig_read_byte(EECONFIG_BACKLIGHT);
 }
 
 void eeconfig_update_backlight(uint8_t val) {
-    eeprom_update_byte(EECONFIG_BACKLIGHT, val);
+    eeconfig_update_byte(EECONFIG_BACKLIGHT, val);
 }
 
 void eeconfig_update_backlight_current(void) {
@@ -109,6 +109,37 @@ RGB hsv_to_rgb_nocie(HSV hsv) {
     return hsv_to_rgb_impl(hsv, false);
 }
 
+// Which of v, p, q and t each of r, g and b takes in every hue region, region 6 being region 0 again
+static const uint8_t hsv_region_channels[7][3] = {
+    {0, 3, 1}, {2, 0, 1}, {1, 0, 3}, {1, 2, 0}, {3, 1, 0}, {0, 1, 2}, {0, 3, 1},
+};
+
+void hsv_to_rgb_batch(const uint8_t *h, const uint8_t *s, const uint8_t *v, uint8_t *r, uint8_t *g, uint8_t *b, uint8_t count) {
+    // Same arithmetic as hsv_to_rgb_impl(), with the region switch turned into table lookups
+    // so that every color runs the same instructions
+    for (uint8_t i = 0; i < count; i++) {
+        uint16_t sat = s[i];
+#ifdef USE_CIE1931_CURVE
+        uint16_t val = pgm_read_byte(&CIE1931_CURVE[v[i]]);
+#else
+        uint16_t val = v[i];
+#endif
+        uint8_t region    = h[i] * 6 / 255;
+        uint8_t remainder = (h[i] * 2 - region * 85) * 3;
+
+        uint8_t channels[4];
+        channels[0] = val;
+        channels[1] = sat ? (val * (255 - sat)) >> 8 : val;
+        channels[2] = sat ? (val * (255 - ((sat * remainder) >> 8))) >> 8 : val;
+        channels[3] = sat ? (val * (255 - ((sat * (255 - remainder)) >> 8))) >> 8 : val;
+
+        const uint8_t *select = hsv_region_channels[region];
+        r[i]                  = channels[select[0]];
+        g[i]                  = channels[select[1]];
+        b[i]                  = channels[select[2]];
+    }
+}
+
 #ifdef RGBW
 void convert_rgb_to_rgbw(rgb_led_t *led) {
     // Determine lowest value in all three colors, put that into
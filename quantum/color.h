@@ -111,6 +111,9 @@ typedef struct PACKED HSV {
 
 RGB hsv_to_rgb(HSV hsv);
 RGB hsv_to_rgb_nocie(HSV hsv);
+// Converts `count` colors held as separate h, s and v arrays into r, g and b arrays, with the same results as hsv_to_rgb().
+// The outputs may be the same arrays as the inputs.
+void hsv_to_rgb_batch(const uint8_t *h, const uint8_t *s, const uint8_t *v, uint8_t *r, uint8_t *g, uint8_t *b, uint8_t count);
 #ifdef RGBW
 void convert_rgb_to_rgbw(rgb_led_t *led);
 #endif
@@ -14,13 +14,18 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <string.h>
+
 #include "dynamic_keymap.h"
 #include "keymap_introspection.h"
 #include "action.h"
+#include "action_layer.h"
 #include "eeprom.h"
 #include "progmem.h"
 #include "send_string.h"
 #include "keycodes.h"
+#include "util.h"
+#include "wait.h"
 
 #ifdef VIA_ENABLE
 #    include "via.h"
@@ -48,8 +53,17 @@
 #    error Unknown total EEPROM size. Cannot derive maximum for dynamic keymaps.
 #endif
 
+#if defined(DYNAMIC_MACRO_ENABLE) && defined(DYNAMIC_MACRO_EEPROM_STORAGE)
+#    include "process_dynamic_macro.h"
+#endif
+
 #ifndef DYNAMIC_KEYMAP_EEPROM_MAX_ADDR
-#    define DYNAMIC_KEYMAP_EEPROM_MAX_ADDR (TOTAL_EEPROM_BYTE_COUNT - 1)
+#    if defined(DYNAMIC_MACRO_ENABLE) && defined(DYNAMIC_MACRO_EEPROM_STORAGE)
+// leave the dynamic macros their region at the end of the EEPROM
+#        define DYNAMIC_KEYMAP_EEPROM_MAX_ADDR (DYNAMIC_MACRO_EEPROM_ADDR - 1)
+#    else
+#        define DYNAMIC_KEYMAP_EEPROM_MAX_ADDR (TOTAL_EEPROM_BYTE_COUNT - 1)
+#    endif
 #endif
 
 #if DYNAMIC_KEYMAP_EEPROM_MAX_ADDR > (TOTAL_EEPROM_BYTE_COUNT - 1)
@@ -57,6 +71,10 @@
 #    error DYNAMIC_KEYMAP_EEPROM_MAX_ADDR is configured to use more space than what is available for the selected EEPROM driver
 #endif
 
+#if defined(DYNAMIC_MACRO_ENABLE) && defined(DYNAMIC_MACRO_EEPROM_STORAGE)
+_Static_assert(DYNAMIC_KEYMAP_EEPROM_MAX_ADDR < DYNAMIC_MACRO_EEPROM_ADDR, "DYNAMIC_KEYMAP_EEPROM_MAX_ADDR overlaps the dynamic macro storage");
+#endif
+
 // Due to usage of uint16_t check for max 65535
 #if DYNAMIC_KEYMAP_EEPROM_MAX_ADDR > 65535
 #    pragma message STR(DYNAMIC_KEYMAP_EEPROM_MAX_ADDR) " > 65535"
@@ -121,10 +139,12 @@ uint16_t dynamic_keymap_get_keycode(uint8_t layer, uint8_t row, uint8_t column)
 
 void dynamic_keymap_set_keycode(uint8_t layer, uint8_t row, uint8_t column, uint16_t keycode) {
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || row >= MATRIX_ROWS || column >= MATRIX_COLS) return;
-    void *address = dynamic_keymap_key_to_eeprom_address(layer, row, column);
+    void *   address = dynamic_keymap_key_to_eeprom_address(layer, row, column);
+    keypos_t key     = {.row = row, .col = column};
     // Big endian, so we can read/write EEPROM directly from host if we want
     eeprom_update_byte(address, (uint8_t)(keycode >> 8));
     eeprom_update_byte(address + 1, (uint8_t)(keycode & 0xFF));
+    layer_transparency_mask_update(layer, key);
 }
 
 #ifdef ENCODER_MAP_ENABLE
@@ -167,31 +187,22 @@ void dynamic_keymap_reset(void) {
     }
 }
 
+uint16_t dynamic_keymap_get_buffer_size(void) {
+    return DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
+}
+
 void dynamic_keymap_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    uint16_t dynamic_keymap_eeprom_size = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
-    void *   source                     = (void *)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
-    uint8_t *target                     = data;
-    for (uint16_t i = 0; i < size; i++) {
-        if (offset + i < dynamic_keymap_eeprom_size) {
-            *target = eeprom_read_byte(source);
-        } else {
-            *target = 0x00;
-        }
-        source++;
-        target++;
-    }
+    uint16_t dynamic_keymap_eeprom_size = dynamic_keymap_get_buffer_size();
+    uint16_t in_range                   = offset < dynamic_keymap_eeprom_size ? MIN(size, dynamic_keymap_eeprom_size - offset) : 0;
+    eeprom_read_block(data, (void *)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset), in_range);
+    memset(data + in_range, 0x00, size - in_range);
 }
 
 void dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    uint16_t dynamic_keymap_eeprom_size = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
-    void *   target                     = (void *)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
-    uint8_t *source                     = data;
-    for (uint16_t i = 0; i < size; i++) {
-        if (offset + i < dynamic_keymap_eeprom_size) {
-            eeprom_update_byte(target, *source);
-        }
-        source++;
-        target++;
+    uint16_t dynamic_keymap_eeprom_size = dynamic_keymap_get_buffer_size();
+    if (offset < dynamic_keymap_eeprom_size) {
+        eeprom_update_block(data, (void *)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset), MIN(size, dynamic_keymap_eeprom_size - offset));
+        layer_transparency_mask_invalidate();
     }
 }
 
@@ -284,6 +295,16 @@ void dynamic_keymap_macro_send(uint8_t id) {
         ++p;
     }
 
+#if defined(SEND_STRING_ENABLE) && defined(SEND_STRING_ASYNC_ENABLE)
+    // Stream the macro straight from EEPROM in the background; the
+    // decoder stops at the first null, malformed or not
+    while (!send_string_async_eeprom(p, DYNAMIC_KEYMAP_MACRO_DELAY, NULL, NULL)) {
+        // Queue is full, type out what is ahead of the macro in the
+        // foreground rather than lose it
+        send_string_task();
+        wait_ms(1);
+    }
+#else
     // Send the macro string by making a temporary string.
     char data[8] = {0};
     // We already checked there was a null at the end of
@@ -337,4 +358,5 @@ void dynamic_keymap_macro_send(uint8_t id) {
         }
         send_string_with_delay(data, DYNAMIC_KEYMAP_MACRO_DELAY);
     }
+#endif
 }
@@ -4,6 +4,7 @@
 #include "eeprom.h"
 #include "eeconfig.h"
 #include "action_layer.h"
+#include "util.h"
 
 #if defined(EEPROM_DRIVER)
 #    include "eeprom_driver.h"
@@ -19,6 +20,161 @@ void via_eeprom_set_valid(bool valid);
 void eeconfig_init_via(void);
 #endif
 
+#ifdef EECONFIG_DEFER_COMMIT_MS
+#    include "timer.h"
+#endif
+
+// RAM copy of the core eeconfig bytes, loaded while a transaction is open
+// or, with EECONFIG_DEFER_COMMIT_MS, while a commit is waiting to be flushed.
+static struct {
+    bool    loaded;
+    uint8_t depth;
+    uint8_t dirty_start;
+    uint8_t dirty_end;
+#ifdef EECONFIG_DEFER_COMMIT_MS
+    uint16_t last_write;
+#endif
+    uint8_t data[EECONFIG_BASE_SIZE];
+} eeconfig_shadow;
+
+_Static_assert(EECONFIG_BASE_SIZE <= UINT8_MAX, "eeconfig shadow offsets must fit in one byte");
+
+static void eeconfig_shadow_load(void) {
+    eeprom_read_block(eeconfig_shadow.data, EECONFIG_MAGIC, EECONFIG_BASE_SIZE);
+    eeconfig_shadow.loaded      = true;
+    eeconfig_shadow.dirty_start = EECONFIG_BASE_SIZE;
+    eeconfig_shadow.dirty_end   = 0;
+}
+
+/** \brief eeconfig begin
+ *
+ * Start collecting eeconfig writes in RAM. Transactions nest, only the outermost eeconfig_commit() writes to EEPROM.
+ */
+void eeconfig_begin(void) {
+    if (!eeconfig_shadow.loaded) {
+        eeconfig_shadow_load();
+    }
+    eeconfig_shadow.depth++;
+}
+
+/** \brief eeconfig commit
+ *
+ * End a transaction started by eeconfig_begin(), writing the changed range of bytes in one go.
+ * With EECONFIG_DEFER_COMMIT_MS, the write is left to eeconfig_task() instead.
+ */
+void eeconfig_commit(void) {
+    if (eeconfig_shadow.depth == 0 || --eeconfig_shadow.depth > 0) {
+        return;
+    }
+#ifndef EECONFIG_DEFER_COMMIT_MS
+    eeconfig_flush();
+#endif
+}
+
+/** \brief eeconfig flush
+ *
+ * Write any collected changes to EEPROM now, even with a transaction open.
+ */
+void eeconfig_flush(void) {
+    if (!eeconfig_shadow.loaded) {
+        return;
+    }
+    uint8_t start = eeconfig_shadow.dirty_start;
+    uint8_t end   = eeconfig_shadow.dirty_end;
+    if (start < end) {
+        eeprom_update_block(&eeconfig_shadow.data[start], (void *)(uintptr_t)start, end - start);
+    }
+    eeconfig_shadow.dirty_start = EECONFIG_BASE_SIZE;
+    eeconfig_shadow.dirty_end   = 0;
+    eeconfig_shadow.loaded      = eeconfig_shadow.depth > 0;
+}
+
+#ifdef EECONFIG_DEFER_COMMIT_MS
+/** \brief eeconfig task
+ *
+ * Flush the collected changes once nothing has been written for EECONFIG_DEFER_COMMIT_MS.
+ */
+void eeconfig_task(void) {
+    if (eeconfig_shadow.loaded && eeconfig_shadow.depth == 0 && timer_elapsed(eeconfig_shadow.last_write) >= EECONFIG_DEFER_COMMIT_MS) {
+        eeconfig_flush();
+    }
+}
+#endif
+
+/** \brief eeconfig read block
+ *
+ * Read from EEPROM, seeing writes not yet committed.
+ */
+void eeconfig_read_block(void *buf, const void *addr, size_t len) {
+    uintptr_t start = (uintptr_t)addr;
+    if (!eeconfig_shadow.loaded || start >= EECONFIG_BASE_SIZE) {
+        eeprom_read_block(buf, addr, len);
+        return;
+    }
+    size_t shadowed = MIN(len, EECONFIG_BASE_SIZE - start);
+    memcpy(buf, &eeconfig_shadow.data[start], shadowed);
+    if (shadowed < len) {
+        eeprom_read_block((uint8_t *)buf + shadowed, (const uint8_t *)addr + shadowed, len - shadowed);
+    }
+}
+
+/** \brief eeconfig update block
+ *
+ * Write to EEPROM, or to the RAM copy while a transaction is open.
+ */
+void eeconfig_update_block(const void *buf, void *addr, size_t len) {
+    uintptr_t start = (uintptr_t)addr;
+#ifdef EECONFIG_DEFER_COMMIT_MS
+    if (!eeconfig_shadow.loaded && start < EECONFIG_BASE_SIZE) {
+        eeconfig_shadow_load();
+    }
+#endif
+    if (!eeconfig_shadow.loaded || start >= EECONFIG_BASE_SIZE) {
+        eeprom_update_block(buf, addr, len);
+        return;
+    }
+    size_t shadowed = MIN(len, EECONFIG_BASE_SIZE - start);
+    memcpy(&eeconfig_shadow.data[start], buf, shadowed);
+    eeconfig_shadow.dirty_start = MIN(eeconfig_shadow.dirty_start, start);
+    eeconfig_shadow.dirty_end   = MAX(eeconfig_shadow.dirty_end, start + shadowed);
+#ifdef EECONFIG_DEFER_COMMIT_MS
+    eeconfig_shadow.last_write = timer_read();
+#endif
+    if (shadowed < len) {
+        eeprom_update_block((const uint8_t *)buf + shadowed, (uint8_t *)addr + shadowed, len - shadowed);
+    }
+}
+
+uint8_t eeconfig_read_byte(const uint8_t *addr) {
+    uint8_t val;
+    eeconfig_read_block(&val, addr, sizeof(val));
+    return val;
+}
+
+uint16_t eeconfig_read_word(const uint16_t *addr) {
+    uint16_t val;
+    eeconfig_read_block(&val, addr, sizeof(val));
+    return val;
+}
+
+uint32_t eeconfig_read_dword(const uint32_t *addr) {
+    uint32_t val;
+    eeconfig_read_block(&val, addr, sizeof(val));
+    return val;
+}
+
+void eeconfig_update_byte(uint8_t *addr, uint8_t val) {
+    eeconfig_update_block(&val, addr, sizeof(val));
+}
+
+void eeconfig_update_word(uint16_t *addr, uint16_t val) {
+    eeconfig_update_block(&val, addr, sizeof(val));
+}
+
+void eeconfig_update_dword(uint32_t *addr, uint32_t val) {
+    eeconfig_update_block(&val, addr, sizeof(val));
+}
+
 /** \brief eeconfig enable
  *
  * FIXME: needs doc
@@ -45,24 +201,29 @@ __attribute__((weak)) void eeconfig_init_kb(void) {
 void eeconfig_init_quantum(void) {
 #if defined(EEPROM_DRIVER)
     eeprom_driver_erase();
+    if (eeconfig_shadow.loaded) {
+        // Anything collected so far was wiped along with the rest
+        eeconfig_shadow_load();
+    }
 #endif
 
-    eeprom_update_word(EECONFIG_MAGIC, EECONFIG_MAGIC_NUMBER);
-    eeprom_update_byte(EECONFIG_DEBUG, 0);
+    eeconfig_begin();
+    eeconfig_update_word(EECONFIG_MAGIC, EECONFIG_MAGIC_NUMBER);
+    eeconfig_update_byte(EECONFIG_DEBUG, 0);
     default_layer_state = (layer_state_t)1 << 0;
-    eeprom_update_byte(EECONFIG_DEFAULT_LAYER, default_layer_state);
+    eeconfig_update_byte(EECONFIG_DEFAULT_LAYER, default_layer_state);
     // Enable oneshot and autocorrect by default: 0b0001 0100 0000 0000
-    eeprom_update_word(EECONFIG_KEYMAP, 0x1400);
-    eeprom_update_byte(EECONFIG_BACKLIGHT, 0);
-    eeprom_update_byte(EECONFIG_AUDIO, 0);
-    eeprom_update_dword(EECONFIG_RGBLIGHT, 0);
-    eeprom_update_byte(EECONFIG_RGBLIGHT_EXTENDED, 0);
-    eeprom_update_byte(EECONFIG_UNUSED, 0);
-    eeprom_update_byte(EECONFIG_UNICODEMODE, 0);
-    eeprom_update_byte(EECONFIG_STENOMODE, 0);
+    eeconfig_update_word(EECONFIG_KEYMAP, 0x1400);
+    eeconfig_update_byte(EECONFIG_BACKLIGHT, 0);
+    eeconfig_update_byte(EECONFIG_AUDIO, 0);
+    eeconfig_update_dword(EECONFIG_RGBLIGHT, 0);
+    eeconfig_update_byte(EECONFIG_RGBLIGHT_EXTENDED, 0);
+    eeconfig_update_byte(EECONFIG_UNUSED, 0);
+    eeconfig_update_byte(EECONFIG_UNICODEMODE, 0);
+    eeconfig_update_byte(EECONFIG_STENOMODE, 0);
     uint64_t dummy = 0;
-    eeprom_update_block(&dummy, EECONFIG_RGB_MATRIX, sizeof(uint64_t));
-    eeprom_update_dword(EECONFIG_HAPTIC, 0);
+    eeconfig_update_block(&dummy, EECONFIG_RGB_MATRIX, sizeof(uint64_t));
+    eeconfig_update_dword(EECONFIG_HAPTIC, 0);
 #if defined(HAPTIC_ENABLE)
     haptic_reset();
 #endif
@@ -84,6 +245,10 @@ void eeconfig_init_quantum(void) {
 #endif
 
     eeconfig_init_kb();
+
+    eeconfig_commit();
+    // A reset is not worth deferring
+    eeconfig_flush();
 }
 
 /** \brief eeconfig initialization
@@ -99,7 +264,7 @@ void eeconfig_init(void) {
  * FIXME: needs doc
  */
 void eeconfig_enable(void) {
-    eeprom_update_word(EECONFIG_MAGIC, EECONFIG_MAGIC_NUMBER);
+    eeconfig_update_word(EECONFIG_MAGIC, EECONFIG_MAGIC_NUMBER);
 }
 
 /** \brief eeconfig disable
@@ -109,8 +274,12 @@ void eeconfig_enable(void) {
 void eeconfig_disable(void) {
 #if defined(EEPROM_DRIVER)
     eeprom_driver_erase();
+    if (eeconfig_shadow.loaded) {
+        eeconfig_shadow_load();
+    }
 #endif
-    eeprom_update_word(EECONFIG_MAGIC, EECONFIG_MAGIC_NUMBER_OFF);
+    eeconfig_update_word(EECONFIG_MAGIC, EECONFIG_MAGIC_NUMBER_OFF);
+    eeconfig_flush();
 }
 
 /** \brief eeconfig is enabled
@@ -118,7 +287,7 @@ void eeconfig_disable(void) {
  * FIXME: needs doc
  */
 bool eeconfig_is_enabled(void) {
-    bool is_eeprom_enabled = (eeprom_read_word(EECONFIG_MAGIC) == EECONFIG_MAGIC_NUMBER);
+    bool is_eeprom_enabled = (eeconfig_read_word(EECONFIG_MAGIC) == EECONFIG_MAGIC_NUMBER);
 #ifdef VIA_ENABLE
     if (is_eeprom_enabled) {
         is_eeprom_enabled = via_eeprom_is_valid();
@@ -132,7 +301,7 @@ bool eeconfig_is_enabled(void) {
  * FIXME: needs doc
  */
 bool eeconfig_is_disabled(void) {
-    bool is_eeprom_disabled = (eeprom_read_word(EECONFIG_MAGIC) == EECONFIG_MAGIC_NUMBER_OFF);
+    bool is_eeprom_disabled = (eeconfig_read_word(EECONFIG_MAGIC) == EECONFIG_MAGIC_NUMBER_OFF);
 #ifdef VIA_ENABLE
     if (!is_eeprom_disabled) {
         is_eeprom_disabled = !via_eeprom_is_valid();
@@ -146,14 +315,14 @@ bool eeconfig_is_disabled(void) {
  * FIXME: needs doc
  */
 uint8_t eeconfig_read_debug(void) {
-    return eeprom_read_byte(EECONFIG_DEBUG);
+    return eeconfig_read_byte(EECONFIG_DEBUG);
 }
 /** \brief eeconfig update debug
  *
  * FIXME: needs doc
  */
 void eeconfig_update_debug(uint8_t val) {
-    eeprom_update_byte(EECONFIG_DEBUG, val);
+    eeconfig_update_byte(EECONFIG_DEBUG, val);
 }
 
 /** \brief eeconfig read default layer
@@ -161,14 +330,14 @@ void eeconfig_update_debug(uint8_t val) {
  * FIXME: needs doc
  */
 uint8_t eeconfig_read_default_layer(void) {
-    return eeprom_read_byte(EECONFIG_DEFAULT_LAYER);
+    return eeconfig_read_byte(EECONFIG_DEFAULT_LAYER);
 }
 /** \brief eeconfig update default layer
  *
  * FIXME: needs doc
  */
 void eeconfig_update_default_layer(uint8_t val) {
-    eeprom_update_byte(EECONFIG_DEFAULT_LAYER, val);
+    eeconfig_update_byte(EECONFIG_DEFAULT_LAYER, val);
 }
 
 /** \brief eeconfig read keymap
@@ -176,14 +345,14 @@ void eeconfig_update_default_layer(uint8_t val) {
  * FIXME: needs doc
  */
 uint16_t eeconfig_read_keymap(void) {
-    return eeprom_read_word(EECONFIG_KEYMAP);
+    return eeconfig_read_word(EECONFIG_KEYMAP);
 }
 /** \brief eeconfig update keymap
  *
  * FIXME: needs doc
  */
 void eeconfig_update_keymap(uint16_t val) {
-    eeprom_update_word(EECONFIG_KEYMAP, val);
+    eeconfig_update_word(EECONFIG_KEYMAP, val);
 }
 
 /** \brief eeconfig read audio
@@ -191,14 +360,14 @@ void eeconfig_update_keymap(uint16_t val) {
  * FIXME: needs doc
  */
 uint8_t eeconfig_read_audio(void) {
-    return eeprom_read_byte(EECONFIG_AUDIO);
+    return eeconfig_read_byte(EECONFIG_AUDIO);
 }
 /** \brief eeconfig update audio
  *
  * FIXME: needs doc
  */
 void eeconfig_update_audio(uint8_t val) {
-    eeprom_update_byte(EECONFIG_AUDIO, val);
+    eeconfig_update_byte(EECONFIG_AUDIO, val);
 }
 
 #if (EECONFIG_KB_DATA_SIZE) == 0
@@ -207,14 +376,14 @@ void eeconfig_update_audio(uint8_t val) {
  * FIXME: needs doc
  */
 uint32_t eeconfig_read_kb(void) {
-    return eeprom_read_dword(EECONFIG_KEYBOARD);
+    return eeconfig_read_dword(EECONFIG_KEYBOARD);
 }
 /** \brief eeconfig update kb
  *
  * FIXME: needs doc
  */
 void eeconfig_update_kb(uint32_t val) {
-    eeprom_update_dword(EECONFIG_KEYBOARD, val);
+    eeconfig_update_dword(EECONFIG_KEYBOARD, val);
 }
 #endif // (EECONFIG_KB_DATA_SIZE) == 0
 
@@ -224,14 +393,14 @@ void eeconfig_update_kb(uint32_t val) {
  * FIXME: needs doc
  */
 uint32_t eeconfig_read_user(void) {
-    return eeprom_read_dword(EECONFIG_USER);
+    return eeconfig_read_dword(EECONFIG_USER);
 }
 /** \brief eeconfig update user
  *
  * FIXME: needs doc
  */
 void eeconfig_update_user(uint32_t val) {
-    eeprom_update_dword(EECONFIG_USER, val);
+    eeconfig_update_dword(EECONFIG_USER, val);
 }
 #endif // (EECONFIG_USER_DATA_SIZE) == 0
 
@@ -240,14 +409,14 @@ void eeconfig_update_user(uint32_t val) {
  * FIXME: needs doc
  */
 uint32_t eeconfig_read_haptic(void) {
-    return eeprom_read_dword(EECONFIG_HAPTIC);
+    return eeconfig_read_dword(EECONFIG_HAPTIC);
 }
 /** \brief eeconfig update haptic
  *
  * FIXME: needs doc
  */
 void eeconfig_update_haptic(uint32_t val) {
-    eeprom_update_dword(EECONFIG_HAPTIC, val);
+    eeconfig_update_dword(EECONFIG_HAPTIC, val);
 }
 
 /** \brief eeconfig read split handedness
@@ -255,14 +424,14 @@ void eeconfig_update_haptic(uint32_t val) {
  * FIXME: needs doc
  */
 bool eeconfig_read_handedness(void) {
-    return !!eeprom_read_byte(EECONFIG_HANDEDNESS);
+    return !!eeconfig_read_byte(EECONFIG_HANDEDNESS);
 }
 /** \brief eeconfig update split handedness
  *
  * FIXME: needs doc
  */
 void eeconfig_update_handedness(bool val) {
-    eeprom_update_byte(EECONFIG_HANDEDNESS, !!val);
+    eeconfig_update_byte(EECONFIG_HANDEDNESS, !!val);
 }
 
 #if (EECONFIG_KB_DATA_SIZE) > 0
@@ -271,7 +440,7 @@ void eeconfig_update_handedness(bool val) {
  * FIXME: needs doc
  */
 bool eeconfig_is_kb_datablock_valid(void) {
-    return eeprom_read_dword(EECONFIG_KEYBOARD) == (EECONFIG_KB_DATA_VERSION);
+    return eeconfig_read_dword(EECONFIG_KEYBOARD) == (EECONFIG_KB_DATA_VERSION);
 }
 /** \brief eeconfig read keyboard data block
  *
@@ -279,7 +448,7 @@ bool eeconfig_is_kb_datablock_valid(void) {
  */
 void eeconfig_read_kb_datablock(void *data) {
     if (eeconfig_is_kb_datablock_valid()) {
-        eeprom_read_block(data, EECONFIG_KB_DATABLOCK, (EECONFIG_KB_DATA_SIZE));
+        eeconfig_read_block(data, EECONFIG_KB_DATABLOCK, (EECONFIG_KB_DATA_SIZE));
     } else {
         memset(data, 0, (EECONFIG_KB_DATA_SIZE));
     }
@@ -289,8 +458,8 @@ void eeconfig_read_kb_datablock(void *data) {
  * FIXME: needs doc
  */
 void eeconfig_update_kb_datablock(const void *data) {
-    eeprom_update_dword(EECONFIG_KEYBOARD, (EECONFIG_KB_DATA_VERSION));
-    eeprom_update_block(data, EECONFIG_KB_DATABLOCK, (EECONFIG_KB_DATA_SIZE));
+    eeconfig_update_dword(EECONFIG_KEYBOARD, (EECONFIG_KB_DATA_VERSION));
+    eeconfig_update_block(data, EECONFIG_KB_DATABLOCK, (EECONFIG_KB_DATA_SIZE));
 }
 /** \brief eeconfig init keyboard data block
  *
@@ -308,7 +477,7 @@ __attribute__((weak)) void eeconfig_init_kb_datablock(void) {
  * FIXME: needs doc
  */
 bool eeconfig_is_user_datablock_valid(void) {
-    return eeprom_read_dword(EECONFIG_USER) == (EECONFIG_USER_DATA_VERSION);
+    return eeconfig_read_dword(EECONFIG_USER) == (EECONFIG_USER_DATA_VERSION);
 }
 /** \brief eeconfig read user data block
  *
@@ -316,7 +485,7 @@ bool eeconfig_is_user_datablock_valid(void) {
  */
 void eeconfig_read_user_datablock(void *data) {
     if (eeconfig_is_user_datablock_valid()) {
-        eeprom_read_block(data, EECONFIG_USER_DATABLOCK, (EECONFIG_USER_DATA_SIZE));
+        eeconfig_read_block(data, EECONFIG_USER_DATABLOCK, (EECONFIG_USER_DATA_SIZE));
     } else {
         memset(data, 0, (EECONFIG_USER_DATA_SIZE));
     }
@@ -326,8 +495,8 @@ void eeconfig_read_user_datablock(void *data) {
  * FIXME: needs doc
  */
 void eeconfig_update_user_datablock(const void *data) {
-    eeprom_update_dword(EECONFIG_USER, (EECONFIG_USER_DATA_VERSION));
-    eeprom_update_block(data, EECONFIG_USER_DATABLOCK, (EECONFIG_USER_DATA_SIZE));
+    eeconfig_update_dword(EECONFIG_USER, (EECONFIG_USER_DATA_VERSION));
+    eeconfig_update_block(data, EECONFIG_USER_DATABLOCK, (EECONFIG_USER_DATA_SIZE));
 }
 /** \brief eeconfig init user data block
  *
@@ -87,6 +87,29 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #define EECONFIG_KEYMAP_SWAP_BACKSLASH_BACKSPACE (1 << 6)
 #define EECONFIG_KEYMAP_NKRO (1 << 7)
 
+/* Transactions
+ *
+ * Between eeconfig_begin() and eeconfig_commit(), writes to the core eeconfig
+ * bytes go to a RAM copy, and are written to EEPROM in one go on commit.
+ * Define EECONFIG_DEFER_COMMIT_MS to also collect writes made outside of a
+ * transaction, and only write them out once nothing has changed for that long.
+ */
+void eeconfig_begin(void);
+void eeconfig_commit(void);
+void eeconfig_flush(void);
+#ifdef EECONFIG_DEFER_COMMIT_MS
+void eeconfig_task(void);
+#endif
+
+uint8_t  eeconfig_read_byte(const uint8_t *addr);
+uint16_t eeconfig_read_word(const uint16_t *addr);
+uint32_t eeconfig_read_dword(const uint32_t *addr);
+void     eeconfig_read_block(void *buf, const void *addr, size_t len);
+void     eeconfig_update_byte(uint8_t *addr, uint8_t val);
+void     eeconfig_update_word(uint16_t *addr, uint16_t val);
+void     eeconfig_update_dword(uint32_t *addr, uint32_t val);
+void     eeconfig_update_block(const void *buf, void *addr, size_t len);
+
 bool eeconfig_is_enabled(void);
 bool eeconfig_is_disabled(void);
 
@@ -157,13 +180,13 @@ void eeconfig_init_user_datablock(void);
     static inline void eeconfig_init_##name(void) {                     \
         dirty_##name = true;                                            \
         if (eeconfig_check_valid_##name()) {                            \
-            eeprom_read_block(&config, offset, sizeof(config));         \
+            eeconfig_read_block(&config, offset, sizeof(config));       \
             dirty_##name = false;                                       \
         }                                                               \
     }                                                                   \
     static inline void eeconfig_flush_##name(bool force) {              \
         if (force || dirty_##name) {                                    \
-            eeprom_update_block(&config, offset, sizeof(config));       \
+            eeconfig_update_block(&config, offset, sizeof(config));     \
             eeconfig_post_flush_##name();                               \
             dirty_##name = false;                                       \
         }                                                               \
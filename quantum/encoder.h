@@ -21,6 +21,7 @@
 #include <stdbool.h>
 #include "gpio.h"
 #include "util.h"
+#include "ring_buffer.h"
 
 #ifdef ENCODER_ENABLE
 
@@ -73,8 +74,15 @@ bool encoder_update_user(uint8_t index, bool clockwise);
 
 #    define NUM_ENCODERS_MAX_PER_SIDE MAX(NUM_ENCODERS_LEFT, NUM_ENCODERS_RIGHT)
 
+// Queue depth must be a power of two, so round the per-side encoder count up
 #    ifndef MAX_QUEUED_ENCODER_EVENTS
-#        define MAX_QUEUED_ENCODER_EVENTS MAX(4, ((NUM_ENCODERS_MAX_PER_SIDE) + 1))
+#        define MAX_QUEUED_ENCODER_EVENTS                        \
+            ((NUM_ENCODERS_MAX_PER_SIDE) <= 4    ? 4             \
+             : (NUM_ENCODERS_MAX_PER_SIDE) <= 8  ? 8             \
+             : (NUM_ENCODERS_MAX_PER_SIDE) <= 16 ? 16            \
+             : (NUM_ENCODERS_MAX_PER_SIDE) <= 32 ? 32            \
+             : (NUM_ENCODERS_MAX_PER_SIDE) <= 64 ? 64            \
+                                                 : 128)
 #    endif // MAX_QUEUED_ENCODER_EVENTS
 
 typedef struct encoder_event_t {
@@ -82,12 +90,12 @@ typedef struct encoder_event_t {
     uint8_t clockwise : 1;
 } encoder_event_t;
 
+RING_BUFFER_DEFINE(encoder_event_queue, encoder_event_t, MAX_QUEUED_ENCODER_EVENTS);
+
 typedef struct encoder_events_t {
-    uint8_t         enqueued;
-    uint8_t         dequeued;
-    uint8_t         head;
-    uint8_t         tail;
-    encoder_event_t queue[MAX_QUEUED_ENCODER_EVENTS];
+    uint8_t               enqueued;
+    uint8_t               dequeued;
+    encoder_event_queue_t queue;
 } encoder_events_t;
 
 // Get the current queued events
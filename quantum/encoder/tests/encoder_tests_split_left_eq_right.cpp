@@ -113,13 +113,9 @@ TEST_F(EncoderSplitTestLeftEqRight, TestOneClockwiseLeftMaster) {
     EXPECT_EQ(updates[0].index, 0);
     EXPECT_EQ(updates[0].clockwise, true);
 
-    int              events_queued = 0;
     encoder_events_t events;
     encoder_retrieve_events(&events);
-    while (events.tail != events.head) {
-        events.tail = (events.tail + 1) % MAX_QUEUED_ENCODER_EVENTS;
-        ++events_queued;
-    }
+    int events_queued = encoder_event_queue_count(&events.queue);
     EXPECT_EQ(events_queued, 0); // No events should be queued on master
 }
 
@@ -137,13 +133,9 @@ TEST_F(EncoderSplitTestLeftEqRight, TestOneClockwiseRightMaster) {
     EXPECT_EQ(updates[0].index, 3);
     EXPECT_EQ(updates[0].clockwise, true);
 
-    int              events_queued = 0;
     encoder_events_t events;
     encoder_retrieve_events(&events);
-    while (events.tail != events.head) {
-        events.tail = (events.tail + 1) % MAX_QUEUED_ENCODER_EVENTS;
-        ++events_queued;
-    }
+    int events_queued = encoder_event_queue_count(&events.queue);
     EXPECT_EQ(events_queued, 0); // No events should be queued on master
 }
 
@@ -159,13 +151,9 @@ TEST_F(EncoderSplitTestLeftEqRight, TestOneClockwiseLeftSlave) {
 
     EXPECT_EQ(updates_array_idx, 0); // no updates received
 
-    int              events_queued = 0;
     encoder_events_t events;
     encoder_retrieve_events(&events);
-    while (events.tail != events.head) {
-        events.tail = (events.tail + 1) % MAX_QUEUED_ENCODER_EVENTS;
-        ++events_queued;
-    }
+    int events_queued = encoder_event_queue_count(&events.queue);
     EXPECT_EQ(events_queued, 1); // One event should be queued on slave
 }
 
@@ -181,12 +169,8 @@ TEST_F(EncoderSplitTestLeftEqRight, TestOneClockwiseRightSlave) {
 
     EXPECT_EQ(updates_array_idx, 0); // no updates received
 
-    int              events_queued = 0;
     encoder_events_t events;
     encoder_retrieve_events(&events);
-    while (events.tail != events.head) {
-        events.tail = (events.tail + 1) % MAX_QUEUED_ENCODER_EVENTS;
-        ++events_queued;
-    }
+    int events_queued = encoder_event_queue_count(&events.queue);
     EXPECT_EQ(events_queued, 1); // One event should be queued on slave
 }
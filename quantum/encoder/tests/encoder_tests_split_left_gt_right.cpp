@@ -115,13 +115,9 @@ TEST_F(EncoderSplitTestLeftGreaterThanRight, TestOneClockwiseLeftMaster) {
     EXPECT_EQ(updates[0].index, 0);
     EXPECT_EQ(updates[0].clockwise, true);
 
-    int              events_queued = 0;
     encoder_events_t events;
     encoder_retrieve_events(&events);
-    while (events.tail != events.head) {
-        events.tail = (events.tail + 1) % MAX_QUEUED_ENCODER_EVENTS;
-        ++events_queued;
-    }
+    int events_queued = encoder_event_queue_count(&events.queue);
     EXPECT_EQ(events_queued, 0); // No events should be queued on master
 }
 
@@ -139,13 +135,9 @@ TEST_F(EncoderSplitTestLeftGreaterThanRight, TestOneClockwiseRightMaster) {
     EXPECT_EQ(updates[0].index, 3);
     EXPECT_EQ(updates[0].clockwise, true);
 
-    int              events_queued = 0;
     encoder_events_t events;
     encoder_retrieve_events(&events);
-    while (events.tail != events.head) {
-        events.tail = (events.tail + 1) % MAX_QUEUED_ENCODER_EVENTS;
-        ++events_queued;
-    }
+    int events_queued = encoder_event_queue_count(&events.queue);
     EXPECT_EQ(events_queued, 0); // No events should be queued on master
 }
 
@@ -161,13 +153,9 @@ TEST_F(EncoderSplitTestLeftGreaterThanRight, TestOneClockwiseLeftSlave) {
 
     EXPECT_EQ(updates_array_idx, 0); // no updates received
 
-    int              events_queued = 0;
     encoder_events_t events;
     encoder_retrieve_events(&events);
-    while (events.tail != events.head) {
-        events.tail = (events.tail + 1) % MAX_QUEUED_ENCODER_EVENTS;
-        ++events_queued;
-    }
+    int events_queued = encoder_event_queue_count(&events.queue);
     EXPECT_EQ(events_queued, 1); // One event should be queued on slave
 }
 
@@ -183,12 +171,8 @@ TEST_F(EncoderSplitTestLeftGreaterThanRight, TestOneClockwiseRightSlave) {
 
     EXPECT_EQ(updates_array_idx, 0); // no updates received
 
-    int              events_queued = 0;
     encoder_events_t events;
     encoder_retrieve_events(&events);
-    while (events.tail != events.head) {
-        events.tail = (events.tail + 1) % MAX_QUEUED_ENCODER_EVENTS;
-        ++events_queued;
-    }
+    int events_queued = encoder_event_queue_count(&events.queue);
     EXPECT_EQ(events_queued, 1); // One event should be queued on slave
 }
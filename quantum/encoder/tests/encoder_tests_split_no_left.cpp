@@ -103,13 +103,9 @@ TEST_F(EncoderSplitTestNoLeft, TestOneClockwiseLeftMaster) {
     EXPECT_EQ(updates[0].index, 1);
     EXPECT_EQ(updates[0].clockwise, true);
 
-    int              events_queued = 0;
     encoder_events_t events;
     encoder_retrieve_events(&events);
-    while (events.tail != events.head) {
-        events.tail = (events.tail + 1) % MAX_QUEUED_ENCODER_EVENTS;
-        ++events_queued;
-    }
+    int events_queued = encoder_event_queue_count(&events.queue);
     EXPECT_EQ(events_queued, 0); // No events should be queued on master
 }
 
@@ -125,12 +121,8 @@ TEST_F(EncoderSplitTestNoLeft, TestOneClockwiseRightSlave) {
 
     EXPECT_EQ(updates_array_idx, 0); // no updates received
 
-    int              events_queued = 0;
     encoder_events_t events;
     encoder_retrieve_events(&events);
-    while (events.tail != events.head) {
-        events.tail = (events.tail + 1) % MAX_QUEUED_ENCODER_EVENTS;
-        ++events_queued;
-    }
+    int events_queued = encoder_event_queue_count(&events.queue);
     EXPECT_EQ(events_queued, 1); // One event should be queued on slave
 }
@@ -83,6 +83,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef SECURE_ENABLE
 #    include "secure.h"
 #endif
+#if defined(SEND_STRING_ENABLE) && defined(SEND_STRING_ASYNC_ENABLE)
+#    include "send_string.h"
+#endif
 #ifdef POINTING_DEVICE_ENABLE
 #    include "pointing_device.h"
 #endif
@@ -104,6 +107,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef VIA_ENABLE
 #    include "via.h"
 #endif
+#ifdef RAW_HID_ROUTER_ENABLE
+#    include "raw_hid.h"
+#endif
 #ifdef DIP_SWITCH_ENABLE
 #    include "dip_switch.h"
 #endif
@@ -612,6 +618,10 @@ void quantum_task(void) {
     }
 #endif
 
+#ifdef AUDIO_ENABLE
+    audio_task();
+#endif
+
 #if defined(AUDIO_ENABLE) && !defined(NO_MUSIC_MODE)
     music_task();
 #endif
@@ -636,6 +646,22 @@ void quantum_task(void) {
     leader_task();
 #endif
 
+#if defined(UNICODE_COMMON_ENABLE) && defined(UNICODEMAP_ASYNC)
+    unicode_task();
+#endif
+
+#if defined(SEND_STRING_ENABLE) && defined(SEND_STRING_ASYNC_ENABLE)
+    send_string_task();
+#endif
+
+#ifdef RAW_HID_ROUTER_ENABLE
+    raw_hid_router_task();
+#endif
+
+#ifdef EECONFIG_DEFER_COMMIT_MS
+    eeconfig_task();
+#endif
+
 #ifdef WPM_ENABLE
     decay_wpm();
 #endif
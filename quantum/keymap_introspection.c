@@ -109,3 +109,29 @@ __attribute__((weak)) combo_t* combo_get(uint16_t combo_idx) {
 }
 
 #endif // defined(COMBO_ENABLE)
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Leader sequences
+
+#if defined(LEADER_ENABLE) && defined(LEADER_SEQUENCE_TABLE)
+
+#    define NUM_LEADER_SEQUENCES_RAW (sizeof(leader_sequences) / sizeof(leader_sequence_t))
+
+_Static_assert(NUM_LEADER_SEQUENCES_RAW <= LEADER_SEQUENCE_TABLE_MAX_SIZE, "Number of leader_sequences exceeds maximum set by LEADER_SEQUENCE_TABLE_MAX_SIZE");
+
+uint16_t leader_sequence_count_raw(void) {
+    return NUM_LEADER_SEQUENCES_RAW;
+}
+// Not weak, leader.c reads the entries with pgm_read_word() and relies on the size checked above
+uint16_t leader_sequence_count(void) {
+    return leader_sequence_count_raw();
+}
+
+const leader_sequence_t* leader_sequence_get_raw(uint16_t sequence_idx) {
+    return &leader_sequences[sequence_idx];
+}
+const leader_sequence_t* leader_sequence_get(uint16_t sequence_idx) {
+    return leader_sequence_get_raw(sequence_idx);
+}
+
+#endif // defined(LEADER_ENABLE) && defined(LEADER_SEQUENCE_TABLE)
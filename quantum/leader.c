@@ -7,6 +7,11 @@
 
 #include <string.h>
 
+#ifdef LEADER_SEQUENCE_TABLE
+#    include "quantum.h"
+#    include "keymap_introspection.h"
+#endif
+
 #ifndef LEADER_TIMEOUT
 #    define LEADER_TIMEOUT 300
 #endif
@@ -14,13 +19,98 @@
 // Leader key stuff
 bool     leading              = false;
 uint16_t leader_time          = 0;
-uint16_t leader_sequence[5]   = {0, 0, 0, 0, 0};
-uint8_t  leader_sequence_size = 0;
+uint16_t leader_sequence[LEADER_SEQUENCE_LENGTH] = {0, 0, 0, 0, 0};
+uint8_t  leader_sequence_size                    = 0;
 
 __attribute__((weak)) void leader_start_user(void) {}
 
 __attribute__((weak)) void leader_end_user(void) {}
 
+#ifdef LEADER_SEQUENCE_TABLE
+_Static_assert(LEADER_SEQUENCE_TABLE_MAX_SIZE <= UINT8_MAX, "LEADER_SEQUENCE_TABLE_MAX_SIZE must fit in a uint8_t");
+
+/* The table is sorted once into leader_table_order, which makes it an implicit
+ * trie: every prefix typed so far corresponds to one contiguous range
+ * [leader_table_lo, leader_table_hi) of entries, and each key only narrows that
+ * range with two binary searches. Shorter sequences pad with KC_NO, so an exact
+ * match for the current prefix is always the first entry of the range.
+ */
+static uint8_t leader_table_order[LEADER_SEQUENCE_TABLE_MAX_SIZE];
+static uint8_t leader_table_count = 0;
+static bool    leader_table_ready = false;
+static uint8_t leader_table_lo    = 0;
+static uint8_t leader_table_hi    = 0;
+
+__attribute__((weak)) bool process_leader_sequence_user(uint16_t index, uint16_t keycode) {
+    return true;
+}
+
+static uint16_t leader_table_key(uint8_t index, uint8_t depth) {
+    return pgm_read_word(&leader_sequence_get(index)->keys[depth]);
+}
+
+static bool leader_table_less(uint8_t a, uint8_t b) {
+    for (uint8_t depth = 0; depth < LEADER_SEQUENCE_LENGTH; depth++) {
+        uint16_t key_a = leader_table_key(a, depth);
+        uint16_t key_b = leader_table_key(b, depth);
+        if (key_a != key_b) {
+            return key_a < key_b;
+        }
+    }
+    return false;
+}
+
+static void leader_table_init(void) {
+    // At most LEADER_SEQUENCE_TABLE_MAX_SIZE, checked at compile time in keymap_introspection.c
+    leader_table_count = leader_sequence_count();
+    for (uint8_t i = 0; i < leader_table_count; i++) {
+        uint8_t j = i;
+        for (; j > 0 && leader_table_less(i, leader_table_order[j - 1]); j--) {
+            leader_table_order[j] = leader_table_order[j - 1];
+        }
+        leader_table_order[j] = i;
+    }
+    leader_table_ready = true;
+}
+
+// first position in [lo, hi) whose key at depth is not below keycode (or above, if upper)
+static uint8_t leader_table_bound(uint8_t lo, uint8_t hi, uint8_t depth, uint16_t keycode, bool upper) {
+    while (lo < hi) {
+        uint8_t  mid = lo + (hi - lo) / 2;
+        uint16_t key = leader_table_key(leader_table_order[mid], depth);
+        if (key < keycode || (upper && key == keycode)) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+static bool leader_table_exact(void) {
+    if (leader_sequence_size == 0 || leader_table_lo >= leader_table_hi) {
+        return false;
+    }
+    return leader_sequence_size == LEADER_SEQUENCE_LENGTH || leader_table_key(leader_table_order[leader_table_lo], leader_sequence_size) == KC_NO;
+}
+
+static void leader_table_advance(uint8_t depth, uint16_t keycode) {
+    leader_table_lo = leader_table_bound(leader_table_lo, leader_table_hi, depth, keycode, false);
+    leader_table_hi = leader_table_bound(leader_table_lo, leader_table_hi, depth, keycode, true);
+}
+
+static void leader_table_complete(void) {
+    if (!leader_table_exact()) {
+        return;
+    }
+    uint8_t  index   = leader_table_order[leader_table_lo];
+    uint16_t keycode = pgm_read_word(&leader_sequence_get(index)->keycode);
+    if (process_leader_sequence_user(index, keycode) && keycode != KC_NO) {
+        tap_code16(keycode);
+    }
+}
+#endif
+
 void leader_start(void) {
     if (leading) {
         return;
@@ -30,10 +120,20 @@ void leader_start(void) {
     leader_time          = timer_read();
     leader_sequence_size = 0;
     memset(leader_sequence, 0, sizeof(leader_sequence));
+#ifdef LEADER_SEQUENCE_TABLE
+    if (!leader_table_ready) {
+        leader_table_init();
+    }
+    leader_table_lo = 0;
+    leader_table_hi = leader_table_count;
+#endif
 }
 
 void leader_end(void) {
     leading = false;
+#ifdef LEADER_SEQUENCE_TABLE
+    leader_table_complete();
+#endif
     leader_end_user();
 }
 
@@ -61,6 +161,31 @@ bool leader_sequence_add(uint16_t keycode) {
     leader_sequence[leader_sequence_size] = keycode;
     leader_sequence_size++;
 
+#ifdef LEADER_SEQUENCE_TABLE
+    leader_table_advance(leader_sequence_size - 1, keycode);
+
+    // finish right away once no sequence can match any more, or only one can
+    // and it is complete (or LEADER_AUTO_COMPLETE allows finishing it early)
+    uint8_t candidates = leader_table_hi - leader_table_lo;
+#    ifdef LEADER_AUTO_COMPLETE
+    if (candidates <= 1) {
+        if (candidates == 1 && !leader_table_exact()) {
+            // jump to the end of the only remaining sequence
+            uint8_t index = leader_table_order[leader_table_lo];
+            while (leader_sequence_size < LEADER_SEQUENCE_LENGTH && leader_table_key(index, leader_sequence_size) != KC_NO) {
+                leader_sequence[leader_sequence_size] = leader_table_key(index, leader_sequence_size);
+                leader_sequence_size++;
+            }
+        }
+        leader_end();
+    }
+#    else
+    if (candidates == 0 || (candidates == 1 && leader_table_exact())) {
+        leader_end();
+    }
+#    endif
+#endif
+
     return true;
 }
 
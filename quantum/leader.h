@@ -1,6 +1,8 @@
 // Copyright 2023 QMK
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#pragma once
+
 #include <stdbool.h>
 #include <stdint.h>
 
@@ -11,6 +13,35 @@
  * \{
  */
 
+#define LEADER_SEQUENCE_LENGTH 5
+
+#ifdef LEADER_SEQUENCE_TABLE
+#    ifndef LEADER_SEQUENCE_TABLE_MAX_SIZE
+#        define LEADER_SEQUENCE_TABLE_MAX_SIZE 64
+#    endif
+
+/**
+ * \brief An entry of the `leader_sequences` table.
+ */
+typedef struct {
+    uint16_t keys[LEADER_SEQUENCE_LENGTH];
+    uint16_t keycode;
+} leader_sequence_t;
+
+#    define LEADER_SEQUENCE(kc, ...) \
+        { .keys = {__VA_ARGS__}, .keycode = (kc) }
+
+/**
+ * \brief User callback, invoked when a sequence from the `leader_sequences` table matches.
+ *
+ * \param index The index of the sequence in the table.
+ * \param keycode The keycode of the sequence.
+ *
+ * \return `true` to tap the keycode, `false` if it was handled here.
+ */
+bool process_leader_sequence_user(uint16_t index, uint16_t keycode);
+#endif
+
 /**
  * \brief User callback, invoked when the leader sequence begins.
  */
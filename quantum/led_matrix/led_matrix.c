@@ -37,6 +37,11 @@ const led_point_t k_led_matrix_center = {112, 32};
 const led_point_t k_led_matrix_center = LED_MATRIX_CENTER;
 #endif
 
+// Distance and angle of each LED from the center, computed once at init for effects that are polar in nature
+#ifdef LED_MATRIX_POLAR_EFFECTS
+led_polar_t g_led_polar[LED_MATRIX_LED_COUNT];
+#endif
+
 // Generic effect runners
 #include "led_matrix_runners.inc"
 
@@ -413,6 +418,15 @@ struct led_matrix_limits_t led_matrix_get_limits(uint8_t iter) {
 void led_matrix_init(void) {
     led_matrix_driver.init();
 
+#ifdef LED_MATRIX_POLAR_EFFECTS
+    for (uint8_t i = 0; i < LED_MATRIX_LED_COUNT; i++) {
+        int16_t dx           = g_led_config.point[i].x - k_led_matrix_center.x;
+        int16_t dy           = g_led_config.point[i].y - k_led_matrix_center.y;
+        g_led_polar[i].dist  = sqrt16(dx * dx + dy * dy);
+        g_led_polar[i].angle = atan2_8(dy, dx);
+    }
+#endif
+
 #ifdef LED_MATRIX_KEYREACTIVE_ENABLED
     g_last_hit_tracker.count = 0;
     for (uint8_t i = 0; i < LED_HITS_TO_REMEMBER; ++i) {
@@ -192,6 +192,9 @@ extern led_eeconfig_t led_matrix_eeconfig;
 
 extern uint32_t     g_led_timer;
 extern led_config_t g_led_config;
+#ifdef LED_MATRIX_POLAR_EFFECTS
+extern led_polar_t g_led_polar[LED_MATRIX_LED_COUNT];
+#endif
 #ifdef LED_MATRIX_KEYREACTIVE_ENABLED
 extern last_hit_t g_last_hit_tracker;
 #endif
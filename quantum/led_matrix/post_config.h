@@ -5,6 +5,13 @@
 
 // clang-format off
 
+// polar
+#if defined(ENABLE_LED_MATRIX_BAND_PINWHEEL) || \
+    defined(ENABLE_LED_MATRIX_BAND_SPIRAL) || \
+    defined(ENABLE_LED_MATRIX_CYCLE_OUT_IN)
+#    define LED_MATRIX_POLAR_EFFECTS
+#endif
+
 // reactive
 #if defined(ENABLE_LED_MATRIX_SOLID_REACTIVE_SIMPLE) || \
     defined(ENABLE_LED_MATRIX_SOLID_REACTIVE_WIDE) || \
@@ -47,8 +47,11 @@ extern "C" {
  */
 
 #include "midi_function_types.h"
-#include "bytequeue/bytequeue.h"
-#define MIDI_INPUT_QUEUE_LENGTH 192
+#include "ring_buffer.h"
+#define MIDI_INPUT_QUEUE_LENGTH 256
+
+// 256 bytes need a 16-bit index, which ring_buffer.h accesses with interrupts masked on AVR
+RING_BUFFER_DEFINE_INDEXED(midi_input_queue, uint8_t, MIDI_INPUT_QUEUE_LENGTH, uint16_t);
 
 typedef enum { IDLE, ONE_BYTE_MESSAGE = 1, TWO_BYTE_MESSAGE = 2, THREE_BYTE_MESSAGE = 3, SYSEX_MESSAGE } input_state_t;
 
@@ -102,8 +105,7 @@ struct _midi_device {
     uint16_t      input_count;
 
     // for queueing data between the input and the processing functions
-    uint8_t     input_queue_data[MIDI_INPUT_QUEUE_LENGTH];
-    byteQueue_t input_queue;
+    midi_input_queue_t input_queue;
 };
 
 /**
@@ -72,6 +72,15 @@
 #    define QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE 1024
 #endif
 
+#ifndef QUANTUM_PAINTER_PALETTE_CACHE_SIZE
+/**
+ * @def This controls the number of converted recolor palettes that are retained for reuse. Repeated drawing of
+ *      images and text with the same colors on the same device skips the conversion to native pixel format. Each
+ *      entry requires approximately 80 bytes of RAM; set to 0 to disable.
+ */
+#    define QUANTUM_PAINTER_PALETTE_CACHE_SIZE 4
+#endif // QUANTUM_PAINTER_PALETTE_CACHE_SIZE
+
 #ifndef QUANTUM_PAINTER_SUPPORTS_256_PALETTE
 /**
  * @def This controls whether 256-color palettes are supported. This has relatively hefty requirements on RAM -- at
@@ -25,6 +25,7 @@ __attribute__((__aligned__(4))) uint8_t qp_internal_global_pixdata_buffer[QUANTU
 // Static buffer to contain a generated color palette
 static bool                                       generated_palette = false;
 static int16_t                                    generated_steps   = -1;
+static painter_device_t                           generated_device  = NULL;
 __attribute__((__aligned__(4))) static qp_pixel_t interpolated_fg_hsv888;
 __attribute__((__aligned__(4))) static qp_pixel_t interpolated_bg_hsv888;
 #if QUANTUM_PAINTER_SUPPORTS_256_PALETTE
@@ -33,6 +34,21 @@ __attribute__((__aligned__(4))) qp_pixel_t qp_internal_global_pixel_lookup_table
 __attribute__((__aligned__(4))) qp_pixel_t qp_internal_global_pixel_lookup_table[16];
 #endif
 
+#if (QUANTUM_PAINTER_PALETTE_CACHE_SIZE) > 0
+// Cache of previously-converted recolor palettes, only retained for palettes of up to 16 entries
+#    define QP_PALETTE_CACHE_MAX_STEPS 16
+typedef struct qp_palette_cache_entry_t {
+    painter_device_t device;
+    int16_t          steps; // 0 signifies an unused entry
+    qp_pixel_t       fg_hsv888;
+    qp_pixel_t       bg_hsv888;
+    qp_pixel_t       palette[QP_PALETTE_CACHE_MAX_STEPS];
+} qp_palette_cache_entry_t;
+
+__attribute__((__aligned__(4))) static qp_palette_cache_entry_t palette_cache[QUANTUM_PAINTER_PALETTE_CACHE_SIZE];
+static uint8_t                                                  palette_cache_next = 0;
+#endif // (QUANTUM_PAINTER_PALETTE_CACHE_SIZE) > 0
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Helpers
 
@@ -68,6 +84,7 @@ void qp_internal_fill_pixdata(painter_device_t device, uint32_t num_pixels, uint
 void qp_internal_invalidate_palette(void) {
     generated_palette = false;
     generated_steps   = -1;
+    generated_device  = NULL;
 }
 
 // Interpolates between two colors to generate a palette
@@ -107,6 +124,73 @@ bool qp_internal_interpolate_palette(qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888,
     return true;
 }
 
+#if (QUANTUM_PAINTER_PALETTE_CACHE_SIZE) > 0
+static qp_palette_cache_entry_t *qp_internal_palette_cache_find(painter_device_t device, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888, int16_t steps) {
+    for (uint8_t i = 0; i < (QUANTUM_PAINTER_PALETTE_CACHE_SIZE); ++i) {
+        qp_palette_cache_entry_t *entry = &palette_cache[i];
+        if (entry->steps == steps && entry->device == device && memcmp(&entry->fg_hsv888, &fg_hsv888, sizeof(fg_hsv888)) == 0 && memcmp(&entry->bg_hsv888, &bg_hsv888, sizeof(bg_hsv888)) == 0) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+static void qp_internal_palette_cache_store(painter_device_t device, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888, int16_t steps) {
+    // Entries are replaced in round-robin order
+    qp_palette_cache_entry_t *entry = &palette_cache[palette_cache_next];
+    palette_cache_next              = (palette_cache_next + 1) % (QUANTUM_PAINTER_PALETTE_CACHE_SIZE);
+
+    entry->device    = device;
+    entry->steps     = steps;
+    entry->fg_hsv888 = fg_hsv888;
+    entry->bg_hsv888 = bg_hsv888;
+    memcpy(entry->palette, qp_internal_global_pixel_lookup_table, steps * sizeof(qp_pixel_t));
+}
+#endif // (QUANTUM_PAINTER_PALETTE_CACHE_SIZE) > 0
+
+// Sets up the global palette as an interpolation between two colors, converted to the device's native pixel format
+bool qp_internal_interpolate_and_convert_palette(painter_device_t device, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888, int16_t steps) {
+    painter_driver_t *driver = (painter_driver_t *)device;
+
+    // If the global palette already matches and was converted for this device, there's nothing to do.
+    if (generated_palette == true && generated_device == device && generated_steps == steps && memcmp(&interpolated_fg_hsv888, &fg_hsv888, sizeof(fg_hsv888)) == 0 && memcmp(&interpolated_bg_hsv888, &bg_hsv888, sizeof(bg_hsv888)) == 0) {
+        return true;
+    }
+
+#if (QUANTUM_PAINTER_PALETTE_CACHE_SIZE) > 0
+    if (steps <= QP_PALETTE_CACHE_MAX_STEPS) {
+        qp_palette_cache_entry_t *entry = qp_internal_palette_cache_find(device, fg_hsv888, bg_hsv888, steps);
+        if (entry) {
+            qp_dprintf("qp_internal_interpolate_and_convert_palette: palette cache hit\n");
+            memcpy(qp_internal_global_pixel_lookup_table, entry->palette, steps * sizeof(qp_pixel_t));
+            generated_palette      = true;
+            generated_steps        = steps;
+            generated_device       = device;
+            interpolated_fg_hsv888 = fg_hsv888;
+            interpolated_bg_hsv888 = bg_hsv888;
+            return true;
+        }
+    }
+#endif // (QUANTUM_PAINTER_PALETTE_CACHE_SIZE) > 0
+
+    // Regenerate the palette, as the previous one may have been converted for a different device
+    qp_internal_invalidate_palette();
+    qp_internal_interpolate_palette(fg_hsv888, bg_hsv888, steps);
+    if (!driver->driver_vtable->palette_convert(device, steps, qp_internal_global_pixel_lookup_table)) {
+        qp_internal_invalidate_palette();
+        return false;
+    }
+    generated_device = device;
+
+#if (QUANTUM_PAINTER_PALETTE_CACHE_SIZE) > 0
+    if (steps <= QP_PALETTE_CACHE_MAX_STEPS) {
+        qp_internal_palette_cache_store(device, fg_hsv888, bg_hsv888, steps);
+    }
+#endif // (QUANTUM_PAINTER_PALETTE_CACHE_SIZE) > 0
+
+    return true;
+}
+
 // Helper shared between image and font rendering -- sets up the global palette to match the palette block specified in the asset. Expects the stream to be positioned at the start of the block header.
 bool qp_internal_load_qgf_palette(qp_stream_t *stream, uint8_t bpp) {
     qgf_palette_v1_t palette_descriptor;
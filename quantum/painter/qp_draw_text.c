@@ -183,8 +183,7 @@ static inline bool qp_drawtext_prepare_font_for_render(painter_device_t device,
     }
 
     // Handle palette if needed
-    const uint16_t palette_entries  = 1u << qff_font->bpp;
-    bool           needs_pixconvert = false;
+    const uint16_t palette_entries = 1u << qff_font->bpp;
     if (qff_font->has_palette) {
         // If this font has a palette, we need to read it out and set up the pixel lookup table
         qp_stream_setpos(&qff_font->stream, offset);
@@ -194,20 +193,20 @@ static inline bool qp_drawtext_prepare_font_for_render(painter_device_t device,
 
         // Skip this block, as far as offset calculations go
         offset += sizeof(qgf_palette_v1_t) + (palette_entries * 3);
-        needs_pixconvert = true;
-    } else {
-        // Interpolate from fg/bg
-        int16_t palette_entries = 1 << qff_font->bpp;
-        needs_pixconvert        = qp_internal_interpolate_palette(fg_hsv888, bg_hsv888, palette_entries);
-    }
 
-    if (needs_pixconvert) {
         // Convert the palette to native format
         if (!driver->driver_vtable->palette_convert(device, palette_entries, qp_internal_global_pixel_lookup_table)) {
             qp_dprintf("qp_drawtext_recolor: fail (could not convert pixels to native)\n");
             qp_comms_stop(device);
             return false;
         }
+    } else {
+        // Interpolate from fg/bg and convert to native format, reusing a cached palette if available
+        if (!qp_internal_interpolate_and_convert_palette(device, fg_hsv888, bg_hsv888, palette_entries)) {
+            qp_dprintf("qp_drawtext_recolor: fail (could not convert pixels to native)\n");
+            qp_comms_stop(device);
+            return false;
+        }
     }
 
     *data_offset = offset;
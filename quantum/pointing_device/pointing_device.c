@@ -35,6 +35,14 @@
 #    endif
 #endif
 
+#if defined(POINTING_DEVICE_MOTION_ACCUMULATE) && !defined(POINTING_DEVICE_MOTION_PIN)
+#    error "POINTING_DEVICE_MOTION_ACCUMULATE requires POINTING_DEVICE_MOTION_PIN to be defined"
+#endif
+
+#if defined(POINTING_DEVICE_MOTION_ACCUMULATE) && defined(SPLIT_POINTING_ENABLE)
+#    error "POINTING_DEVICE_MOTION_ACCUMULATE is not supported when sharing the pointing device report between sides"
+#endif
+
 #if defined(SPLIT_POINTING_ENABLE)
 #    include "transactions.h"
 #    include "keyboard.h"
@@ -81,6 +89,67 @@ static bool           pointing_device_force_send = false;
 
 extern const pointing_device_driver_t pointing_device_driver;
 
+#ifdef POINTING_DEVICE_MOTION_PIN
+/**
+ * @brief Checks whether the sensor is signalling pending motion data
+ *
+ * @return true if the motion pin is asserted
+ */
+static inline bool pointing_device_motion_pin_active(void) {
+#    ifdef POINTING_DEVICE_MOTION_PIN_ACTIVE_LOW
+    return !gpio_read_pin(POINTING_DEVICE_MOTION_PIN);
+#    else
+    return gpio_read_pin(POINTING_DEVICE_MOTION_PIN);
+#    endif
+}
+#endif
+
+#ifdef POINTING_DEVICE_MOTION_ACCUMULATE
+typedef struct {
+    int32_t x;
+    int32_t y;
+    int32_t v;
+    int32_t h;
+} pointing_device_motion_accumulator_t;
+
+static pointing_device_motion_accumulator_t motion_accumulator = {};
+
+/**
+ * @brief Reads the sensor if it has signalled motion and adds the deltas to the accumulator
+ *
+ * Runs on every pass of the pointing device task, independent of POINTING_DEVICE_TASK_THROTTLE_MS, so
+ * bursts are only read while the sensor has data pending.
+ */
+static void pointing_device_motion_sample(void) {
+    if (!pointing_device_motion_pin_active()) {
+        return;
+    }
+
+    report_mouse_t sample = {.buttons = local_mouse_report.buttons};
+    sample                = pointing_device_driver.get_report(sample);
+
+    motion_accumulator.x += sample.x;
+    motion_accumulator.y += sample.y;
+    motion_accumulator.v += sample.v;
+    motion_accumulator.h += sample.h;
+    local_mouse_report.buttons = sample.buttons;
+}
+
+/**
+ * @brief Removes as much of an accumulated value as fits in a single report
+ *
+ * @param[in,out] accumulator accumulated value, left holding the remainder
+ * @param[in] min smallest value the report field can hold
+ * @param[in] max largest value the report field can hold
+ * @return value to place in the report
+ */
+static inline int32_t pointing_device_motion_drain(int32_t *accumulator, int32_t min, int32_t max) {
+    int32_t value = *accumulator < min ? min : (*accumulator > max ? max : *accumulator);
+    *accumulator -= value;
+    return value;
+}
+#endif
+
 /**
  * @brief Keyboard level code pointing device initialisation
  *
@@ -233,6 +302,10 @@ __attribute__((weak)) bool pointing_device_task(void) {
     };
 #endif
 
+#ifdef POINTING_DEVICE_MOTION_ACCUMULATE
+    pointing_device_motion_sample();
+#endif
+
 #if (POINTING_DEVICE_TASK_THROTTLE_MS > 0)
     static uint32_t last_exec = 0;
     if (timer_elapsed32(last_exec) < POINTING_DEVICE_TASK_THROTTLE_MS) {
@@ -242,36 +315,39 @@ __attribute__((weak)) bool pointing_device_task(void) {
 #endif
 
     // Gather report info
-#ifdef POINTING_DEVICE_MOTION_PIN
-#    if defined(SPLIT_POINTING_ENABLE)
-#        error POINTING_DEVICE_MOTION_PIN not supported when sharing the pointing device report between sides.
-#    endif
-#    ifdef POINTING_DEVICE_MOTION_PIN_ACTIVE_LOW
-    if (!gpio_read_pin(POINTING_DEVICE_MOTION_PIN))
-#    else
-    if (gpio_read_pin(POINTING_DEVICE_MOTION_PIN))
+#if defined(POINTING_DEVICE_MOTION_ACCUMULATE)
+    // Emit what fits into one report, anything beyond that is carried into the next interval
+    local_mouse_report.x = pointing_device_motion_drain(&motion_accumulator.x, XY_REPORT_MIN, XY_REPORT_MAX);
+    local_mouse_report.y = pointing_device_motion_drain(&motion_accumulator.y, XY_REPORT_MIN, XY_REPORT_MAX);
+    local_mouse_report.v = pointing_device_motion_drain(&motion_accumulator.v, HV_REPORT_MIN, HV_REPORT_MAX);
+    local_mouse_report.h = pointing_device_motion_drain(&motion_accumulator.h, HV_REPORT_MIN, HV_REPORT_MAX);
+#else
+#    ifdef POINTING_DEVICE_MOTION_PIN
+#        if defined(SPLIT_POINTING_ENABLE)
+#            error POINTING_DEVICE_MOTION_PIN not supported when sharing the pointing device report between sides.
+#        endif
+    if (pointing_device_motion_pin_active()) {
 #    endif
-    {
-#endif
 
-#if defined(SPLIT_POINTING_ENABLE)
-#    if defined(POINTING_DEVICE_COMBINED)
+#    if defined(SPLIT_POINTING_ENABLE)
+#        if defined(POINTING_DEVICE_COMBINED)
         static uint8_t old_buttons = 0;
         local_mouse_report.buttons = old_buttons;
         local_mouse_report         = pointing_device_driver.get_report(local_mouse_report);
         old_buttons                = local_mouse_report.buttons;
-#    elif defined(POINTING_DEVICE_LEFT) || defined(POINTING_DEVICE_RIGHT)
+#        elif defined(POINTING_DEVICE_LEFT) || defined(POINTING_DEVICE_RIGHT)
         local_mouse_report = POINTING_DEVICE_THIS_SIDE ? pointing_device_driver.get_report(local_mouse_report) : shared_mouse_report;
+#        else
+#            error "You need to define the side(s) the pointing device is on. POINTING_DEVICE_COMBINED / POINTING_DEVICE_LEFT / POINTING_DEVICE_RIGHT"
+#        endif
 #    else
-#        error "You need to define the side(s) the pointing device is on. POINTING_DEVICE_COMBINED / POINTING_DEVICE_LEFT / POINTING_DEVICE_RIGHT"
-#    endif
-#else
     local_mouse_report = pointing_device_driver.get_report(local_mouse_report);
-#endif // defined(SPLIT_POINTING_ENABLE)
+#    endif // defined(SPLIT_POINTING_ENABLE)
 
-#ifdef POINTING_DEVICE_MOTION_PIN
+#    ifdef POINTING_DEVICE_MOTION_PIN
     }
-#endif
+#    endif
+#endif // defined(POINTING_DEVICE_MOTION_ACCUMULATE)
 
     // allow kb to intercept and modify report
 #if defined(SPLIT_POINTING_ENABLE) && defined(POINTING_DEVICE_COMBINED)
@@ -377,16 +453,16 @@ void pointing_device_set_cpi_on_side(bool left, uint16_t cpi) {
 }
 
 /**
- * @brief clamps int16_t to int8_t
+ * @brief clamps hv_clamp_range_t to mouse_hv_report_t
  *
- * @param[in] int16_t value
- * @return int8_t clamped value
+ * @param[in] hv_clamp_range_t value
+ * @return mouse_hv_report_t clamped value
  */
-static inline int8_t pointing_device_hv_clamp(int16_t value) {
-    if (value < INT8_MIN) {
-        return INT8_MIN;
-    } else if (value > INT8_MAX) {
-        return INT8_MAX;
+static inline mouse_hv_report_t pointing_device_hv_clamp(hv_clamp_range_t value) {
+    if (value < HV_REPORT_MIN) {
+        return HV_REPORT_MIN;
+    } else if (value > HV_REPORT_MAX) {
+        return HV_REPORT_MAX;
     } else {
         return value;
     }
@@ -421,8 +497,8 @@ static inline mouse_xy_report_t pointing_device_xy_clamp(clamp_range_t value) {
 report_mouse_t pointing_device_combine_reports(report_mouse_t left_report, report_mouse_t right_report) {
     left_report.x = pointing_device_xy_clamp((clamp_range_t)left_report.x + right_report.x);
     left_report.y = pointing_device_xy_clamp((clamp_range_t)left_report.y + right_report.y);
-    left_report.h = pointing_device_hv_clamp((int16_t)left_report.h + right_report.h);
-    left_report.v = pointing_device_hv_clamp((int16_t)left_report.v + right_report.v);
+    left_report.h = pointing_device_hv_clamp((hv_clamp_range_t)left_report.h + right_report.h);
+    left_report.v = pointing_device_hv_clamp((hv_clamp_range_t)left_report.v + right_report.v);
     left_report.buttons |= right_report.buttons;
     return left_report;
 }
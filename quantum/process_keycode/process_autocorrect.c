@@ -22,6 +22,134 @@
 static uint8_t typo_buffer[AUTOCORRECT_MAX_LENGTH] = {KC_SPC};
 static uint8_t typo_buffer_size                    = 1;
 
+#ifdef AUTOCORRECT_EXTERNAL_FLASH
+#    ifndef FLASH_SPI
+#        error "AUTOCORRECT_EXTERNAL_FLASH requires FLASH_DRIVER = spi"
+#    endif
+#    if defined(__AVR__)
+#        error "AUTOCORRECT_EXTERNAL_FLASH is not supported on AVR"
+#    endif
+#    include "flash_spi.h"
+#    include "debug.h"
+
+#    ifndef AUTOCORRECT_DATA_PAGE_SIZE
+#        error "autocorrect_data.h was not generated for external flash, rerun qmk generate-autocorrect-data with --external-flash"
+#    endif
+// Address of the image written from autocorrect_data.bin
+#    ifndef AUTOCORRECT_EXTERNAL_FLASH_ADDRESS
+#        define AUTOCORRECT_EXTERNAL_FLASH_ADDRESS 0
+#    endif
+// Pages at the start of the image, i.e. the top levels of the trie, kept in RAM for good
+#    ifndef AUTOCORRECT_EXTERNAL_FLASH_PINNED_PAGES
+#        define AUTOCORRECT_EXTERNAL_FLASH_PINNED_PAGES 2
+#    endif
+// Least recently used pages from deeper in the trie kept in RAM
+#    ifndef AUTOCORRECT_EXTERNAL_FLASH_CACHE_PAGES
+#        define AUTOCORRECT_EXTERNAL_FLASH_CACHE_PAGES 4
+#    endif
+
+#    define AUTOCORRECT_DATA_LINK_SIZE 3
+#    define AUTOCORRECT_FLASH_HEADER_SIZE 16
+#    define AUTOCORRECT_FLASH_NO_PAGE UINT32_MAX
+
+typedef uint32_t autocorrect_state_t;
+
+typedef struct {
+    uint32_t page;
+    uint8_t  last_used;
+    uint8_t  data[AUTOCORRECT_DATA_PAGE_SIZE];
+} autocorrect_flash_page_t;
+
+static enum { AUTOCORRECT_FLASH_UNCHECKED, AUTOCORRECT_FLASH_VALID, AUTOCORRECT_FLASH_INVALID } autocorrect_flash_state = AUTOCORRECT_FLASH_UNCHECKED;
+
+static uint8_t                  autocorrect_flash_pinned[AUTOCORRECT_EXTERNAL_FLASH_PINNED_PAGES][AUTOCORRECT_DATA_PAGE_SIZE];
+static autocorrect_flash_page_t autocorrect_flash_cache[AUTOCORRECT_EXTERNAL_FLASH_CACHE_PAGES];
+static uint8_t                  autocorrect_flash_clock;
+
+/**
+ * @brief Checks the image header written by qmk generate-autocorrect-data against the
+ * compiled in dictionary settings, and loads the pinned pages
+ *
+ * @return true if the image can be used
+ */
+static bool autocorrect_flash_load(void) {
+    uint8_t header[AUTOCORRECT_FLASH_HEADER_SIZE];
+
+    flash_init();
+    if (flash_read_block(AUTOCORRECT_EXTERNAL_FLASH_ADDRESS, header, sizeof(header)) != FLASH_STATUS_SUCCESS) {
+        return false;
+    }
+
+    uint32_t size      = header[4] | (uint32_t)header[5] << 8 | (uint32_t)header[6] << 16 | (uint32_t)header[7] << 24;
+    uint16_t page_size = header[10] | header[11] << 8;
+    if (memcmp(header, "QAC\x01", 4) != 0 || size != DICTIONARY_SIZE || header[8] != AUTOCORRECT_MIN_LENGTH || header[9] != AUTOCORRECT_MAX_LENGTH || page_size != AUTOCORRECT_DATA_PAGE_SIZE) {
+        dprintln("autocorrect: external flash image does not match autocorrect_data.h");
+        return false;
+    }
+
+    for (uint8_t i = 0; i < AUTOCORRECT_EXTERNAL_FLASH_PINNED_PAGES && (uint32_t)i * AUTOCORRECT_DATA_PAGE_SIZE < DICTIONARY_SIZE; i++) {
+        if (flash_read_block(AUTOCORRECT_EXTERNAL_FLASH_ADDRESS + AUTOCORRECT_FLASH_HEADER_SIZE + (uint32_t)i * AUTOCORRECT_DATA_PAGE_SIZE, autocorrect_flash_pinned[i], AUTOCORRECT_DATA_PAGE_SIZE) != FLASH_STATUS_SUCCESS) {
+            return false;
+        }
+    }
+    for (uint8_t i = 0; i < AUTOCORRECT_EXTERNAL_FLASH_CACHE_PAGES; i++) {
+        autocorrect_flash_cache[i].page = AUTOCORRECT_FLASH_NO_PAGE;
+    }
+    return true;
+}
+
+/**
+ * @brief Reads one byte of the trie, through the pinned pages or the page cache
+ *
+ * @return the byte, or 0 (end of node) if it could not be read
+ */
+static uint8_t autocorrect_read_byte(autocorrect_state_t offset) {
+    uint32_t page  = offset / AUTOCORRECT_DATA_PAGE_SIZE;
+    uint16_t index = offset % AUTOCORRECT_DATA_PAGE_SIZE;
+
+    if (page < AUTOCORRECT_EXTERNAL_FLASH_PINNED_PAGES) {
+        return autocorrect_flash_pinned[page][index];
+    }
+
+    autocorrect_flash_page_t *victim = &autocorrect_flash_cache[0];
+    for (uint8_t i = 0; i < AUTOCORRECT_EXTERNAL_FLASH_CACHE_PAGES; i++) {
+        autocorrect_flash_page_t *entry = &autocorrect_flash_cache[i];
+        if (entry->page == page) {
+            entry->last_used = ++autocorrect_flash_clock;
+            return entry->data[index];
+        }
+        // Prefer an empty slot, otherwise the oldest one. Ages wrap around, so compare them relative to the clock
+        if (victim->page != AUTOCORRECT_FLASH_NO_PAGE && (entry->page == AUTOCORRECT_FLASH_NO_PAGE || (uint8_t)(autocorrect_flash_clock - entry->last_used) > (uint8_t)(autocorrect_flash_clock - victim->last_used))) {
+            victim = entry;
+        }
+    }
+
+    if (flash_read_block(AUTOCORRECT_EXTERNAL_FLASH_ADDRESS + AUTOCORRECT_FLASH_HEADER_SIZE + page * AUTOCORRECT_DATA_PAGE_SIZE, victim->data, AUTOCORRECT_DATA_PAGE_SIZE) != FLASH_STATUS_SUCCESS) {
+        victim->page = AUTOCORRECT_FLASH_NO_PAGE;
+        return 0;
+    }
+    victim->page      = page;
+    victim->last_used = ++autocorrect_flash_clock;
+    return victim->data[index];
+}
+#else
+#    define AUTOCORRECT_DATA_LINK_SIZE 2
+#    define autocorrect_read_byte(offset) pgm_read_byte(autocorrect_data + (offset))
+
+typedef uint16_t autocorrect_state_t;
+#endif
+
+/**
+ * @brief Reads a little endian link to a child node
+ */
+static inline autocorrect_state_t autocorrect_read_link(autocorrect_state_t offset) {
+    autocorrect_state_t link = 0;
+    for (uint8_t i = 0; i < AUTOCORRECT_DATA_LINK_SIZE; i++) {
+        link |= (autocorrect_state_t)autocorrect_read_byte(offset + i) << (8 * i);
+    }
+    return link;
+}
+
 /**
  * @brief function for querying the enabled state of autocorrect
  *
@@ -278,23 +406,32 @@ bool process_autocorrect(uint16_t keycode, keyrecord_t *record) {
         return true;
     }
 
+#ifdef AUTOCORRECT_EXTERNAL_FLASH
+    if (autocorrect_flash_state == AUTOCORRECT_FLASH_UNCHECKED) {
+        autocorrect_flash_state = autocorrect_flash_load() ? AUTOCORRECT_FLASH_VALID : AUTOCORRECT_FLASH_INVALID;
+    }
+    if (autocorrect_flash_state != AUTOCORRECT_FLASH_VALID) {
+        return true;
+    }
+#endif
+
     // Check for typo in buffer using a trie stored in `autocorrect_data`.
-    uint16_t state = 0;
-    uint8_t  code  = pgm_read_byte(autocorrect_data + state);
+    autocorrect_state_t state = 0;
+    uint8_t             code  = autocorrect_read_byte(state);
     for (int8_t i = typo_buffer_size - 1; i >= 0; --i) {
         uint8_t const key_i = typo_buffer[i];
 
         if (code & 64) { // Check for match in node with multiple children.
             code &= 63;
-            for (; code != key_i; code = pgm_read_byte(autocorrect_data + (state += 3))) {
+            for (; code != key_i; code = autocorrect_read_byte(state += 1 + AUTOCORRECT_DATA_LINK_SIZE)) {
                 if (!code) return true;
             }
             // Follow link to child node.
-            state = (pgm_read_byte(autocorrect_data + state + 1) | pgm_read_byte(autocorrect_data + state + 2) << 8);
+            state = autocorrect_read_link(state + 1);
             // Check for match in node with single child.
         } else if (code != key_i) {
             return true;
-        } else if (!(code = pgm_read_byte(autocorrect_data + (++state)))) {
+        } else if (!(code = autocorrect_read_byte(++state))) {
             ++state;
         }
 
@@ -304,11 +441,21 @@ bool process_autocorrect(uint16_t keycode, keyrecord_t *record) {
             return true;
         }
 
-        code = pgm_read_byte(autocorrect_data + state);
+        code = autocorrect_read_byte(state);
 
         if (code & 128) { // A typo was found! Apply autocorrect.
             const uint8_t backspaces = (code & 63) + !record->event.pressed;
-            const char *  changes    = (const char *)(autocorrect_data + state + 1);
+#ifdef AUTOCORRECT_EXTERNAL_FLASH
+            // Copied to RAM, which the _P string functions read directly on ARM
+            char changes[AUTOCORRECT_MAX_LENGTH + 10] = {0};
+            for (uint8_t i = 0; i < sizeof(changes) - 1; ++i) {
+                if (!(changes[i] = autocorrect_read_byte(state + 1 + i))) {
+                    break;
+                }
+            }
+#else
+            const char *changes = (const char *)(autocorrect_data + state + 1);
+#endif
 
             /* Gather info about the typo'd word
              *
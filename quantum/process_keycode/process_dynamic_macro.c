@@ -22,10 +22,17 @@
 #include "keycodes.h"
 #include "debug.h"
 #include "wait.h"
+#include "timer.h"
 
 #ifdef BACKLIGHT_ENABLE
 #    include "backlight.h"
 #endif
+#ifdef DYNAMIC_MACRO_EEPROM_STORAGE
+#    include "eeconfig.h"
+#    ifdef VIA_ENABLE
+#        include "via.h"
+#    endif
+#endif
 
 // default feedback method
 void dynamic_macro_led_blink(void) {
@@ -65,6 +72,347 @@ __attribute__((weak)) bool dynamic_macro_valid_key_user(uint16_t keycode, keyrec
 #define DYNAMIC_MACRO_CURRENT_LENGTH(BEGIN, POINTER) ((int)(direction * ((POINTER) - (BEGIN))))
 #define DYNAMIC_MACRO_CURRENT_CAPACITY(BEGIN, END2) ((int)(direction * ((END2) - (BEGIN)) + 1))
 
+#ifdef DYNAMIC_MACRO_EEPROM_STORAGE
+
+/* Both macros share an EEPROM region the same way as the RAM buffer
+ * described below: macro 1 grows from the start of the data area and
+ * macro 2 from its end, byte by byte, so they can take any share of
+ * it. A small header holds the length of each macro and is written
+ * last, so a recording interrupted by a power loss leaves the macro
+ * empty rather than half-written.
+ *
+ * Events are stored as a stream of variable length entries instead
+ * of full keyrecord_t copies:
+ *
+ *   byte 0   bit 7     pressed
+ *            bits 6-4  event type
+ *            bit 3     tap byte follows
+ *            bit 2     keycode follows
+ *            bits 1-0  number of time delta bytes (0 to 2)
+ *   byte 1   key column
+ *   byte 2   key row
+ *   [tap]    tap count in bits 7-4, interrupted in bit 0
+ *   [keycode lo, keycode hi]
+ *   [delta lo, [delta hi]]  time since the previous event
+ *
+ * While recording, entries are gathered in a small RAM chunk which is
+ * flushed whenever it fills up. Playback reads entries straight from
+ * EEPROM.
+ */
+typedef struct PACKED {
+    uint16_t magic;
+    uint16_t length[2];
+} dynamic_macro_eeprom_header_t;
+
+#    define DYNAMIC_MACRO_EEPROM_MAGIC 0x4D01
+#    define DYNAMIC_MACRO_EEPROM_HEADER ((dynamic_macro_eeprom_header_t *)(DYNAMIC_MACRO_EEPROM_ADDR))
+#    define DYNAMIC_MACRO_EEPROM_DATA ((uint8_t *)(DYNAMIC_MACRO_EEPROM_ADDR) + sizeof(dynamic_macro_eeprom_header_t))
+#    define DYNAMIC_MACRO_EEPROM_DATA_SIZE ((uint16_t)(DYNAMIC_MACRO_EEPROM_SIZE - sizeof(dynamic_macro_eeprom_header_t)))
+#    define DYNAMIC_MACRO_EVENT_MAX_SIZE 8
+
+_Static_assert(DYNAMIC_MACRO_EEPROM_SIZE > sizeof(dynamic_macro_eeprom_header_t) + DYNAMIC_MACRO_EVENT_MAX_SIZE, "DYNAMIC_MACRO_EEPROM_SIZE is too small to hold any event");
+_Static_assert(DYNAMIC_MACRO_EEPROM_SIZE <= UINT16_MAX, "DYNAMIC_MACRO_EEPROM_SIZE must fit in 16 bits");
+_Static_assert(DYNAMIC_MACRO_EEPROM_CHUNK_SIZE >= DYNAMIC_MACRO_EVENT_MAX_SIZE && DYNAMIC_MACRO_EEPROM_CHUNK_SIZE <= 255, "DYNAMIC_MACRO_EEPROM_CHUNK_SIZE must be between 8 and 255");
+_Static_assert(DYNAMIC_MACRO_EEPROM_ADDR >= EECONFIG_SIZE, "DYNAMIC_MACRO_EEPROM_ADDR overlaps the eeconfig data");
+_Static_assert(DYNAMIC_MACRO_EEPROM_ADDR + DYNAMIC_MACRO_EEPROM_SIZE <= TOTAL_EEPROM_BYTE_COUNT, "Dynamic macro storage does not fit in the EEPROM");
+#    ifdef VIA_ENABLE
+_Static_assert(DYNAMIC_MACRO_EEPROM_ADDR >= VIA_EEPROM_CONFIG_END, "DYNAMIC_MACRO_EEPROM_ADDR overlaps the VIA data");
+#    endif
+
+#    define DYNAMIC_MACRO_SLOT(direction) ((direction) > 0 ? 0 : 1)
+
+/* Stored length of each macro in bytes, loaded from the header on
+ * first use. */
+static uint16_t macro_length[2];
+static bool     macro_length_loaded = false;
+
+/* Recording state: the number of bytes streamed so far, the length
+ * the macro is cut back to when it ends (just after the last key-up
+ * event), and the chunk not yet written out. */
+static uint16_t record_length;
+static uint16_t record_trimmed_length;
+static uint16_t record_last_time;
+static uint16_t chunk_offset;
+static uint8_t  chunk_used;
+static uint8_t  chunk[DYNAMIC_MACRO_EEPROM_CHUNK_SIZE];
+
+/* 0   - no macro is being recorded right now
+ * 1,2 - either macro 1 or 2 is being recorded */
+static uint8_t macro_id = 0;
+
+static void dynamic_macro_eeprom_load(void) {
+    if (macro_length_loaded) {
+        return;
+    }
+    macro_length_loaded = true;
+
+    dynamic_macro_eeprom_header_t header;
+    eeprom_read_block(&header, DYNAMIC_MACRO_EEPROM_HEADER, sizeof(header));
+    if (header.magic == DYNAMIC_MACRO_EEPROM_MAGIC && header.length[0] <= DYNAMIC_MACRO_EEPROM_DATA_SIZE && header.length[1] <= DYNAMIC_MACRO_EEPROM_DATA_SIZE - header.length[0]) {
+        macro_length[0] = header.length[0];
+        macro_length[1] = header.length[1];
+    } else {
+        dprintln("dynamic macro: no valid macros in EEPROM");
+        macro_length[0] = 0;
+        macro_length[1] = 0;
+    }
+}
+
+static void dynamic_macro_eeprom_save(void) {
+    dynamic_macro_eeprom_header_t header = {.magic = DYNAMIC_MACRO_EEPROM_MAGIC, .length = {macro_length[0], macro_length[1]}};
+    eeprom_update_block(&header, DYNAMIC_MACRO_EEPROM_HEADER, sizeof(header));
+}
+
+/* Address of the given byte of a macro's stream. Macro 2 is stored
+ * backwards from the end of the data area. */
+static uint8_t *dynamic_macro_eeprom_addr(int8_t direction, uint16_t offset) {
+    return direction > 0 ? DYNAMIC_MACRO_EEPROM_DATA + offset : DYNAMIC_MACRO_EEPROM_DATA + DYNAMIC_MACRO_EEPROM_DATA_SIZE - 1 - offset;
+}
+
+static void dynamic_macro_chunk_flush(int8_t direction) {
+    if (chunk_used == 0) {
+        return;
+    }
+    if (direction > 0) {
+        eeprom_update_block(chunk, dynamic_macro_eeprom_addr(direction, chunk_offset), chunk_used);
+    } else {
+        /* Reverse the chunk so that it can be written as one block
+         * ending at the address of its first byte. */
+        for (uint8_t i = 0, j = chunk_used - 1; i < j; i++, j--) {
+            uint8_t tmp = chunk[i];
+            chunk[i]    = chunk[j];
+            chunk[j]    = tmp;
+        }
+        eeprom_update_block(chunk, dynamic_macro_eeprom_addr(direction, chunk_offset + chunk_used - 1), chunk_used);
+    }
+    chunk_offset += chunk_used;
+    chunk_used = 0;
+}
+
+/**
+ * Encode a record into its stored form.
+ *
+ * @param[out] buffer At least DYNAMIC_MACRO_EVENT_MAX_SIZE bytes.
+ * @param[in]  delta  Time elapsed since the previous event.
+ * @return The number of bytes used.
+ */
+static uint8_t dynamic_macro_event_encode(uint8_t *buffer, keyrecord_t *record, uint16_t delta) {
+    uint8_t length = 3;
+
+    buffer[0] = (record->event.pressed ? 0x80 : 0) | ((record->event.type & 0x07) << 4);
+    buffer[1] = record->event.key.col;
+    buffer[2] = record->event.key.row;
+#    ifndef NO_ACTION_TAPPING
+    uint8_t tap = (record->tap.count << 4) | (record->tap.interrupted ? 0x01 : 0);
+    if (tap) {
+        buffer[0] |= 0x08;
+        buffer[length++] = tap;
+    }
+#    endif
+#    if defined(COMBO_ENABLE) || defined(REPEAT_KEY_ENABLE)
+    if (record->keycode) {
+        buffer[0] |= 0x04;
+        buffer[length++] = record->keycode & 0xFF;
+        buffer[length++] = record->keycode >> 8;
+    }
+#    endif
+    if (delta) {
+        buffer[length++] = delta & 0xFF;
+        if (delta > 0xFF) {
+            buffer[length++] = delta >> 8;
+            buffer[0] |= 0x02;
+        } else {
+            buffer[0] |= 0x01;
+        }
+    }
+    return length;
+}
+
+/**
+ * Decode the stored event starting at *offset, reading it from EEPROM.
+ *
+ * @param[in,out] offset Advanced past the event.
+ * @param[out]    delta  Time elapsed since the previous event.
+ */
+static keyrecord_t dynamic_macro_event_decode(int8_t direction, uint16_t *offset, uint16_t *delta) {
+    keyrecord_t record = {};
+    uint8_t     flags  = eeprom_read_byte(dynamic_macro_eeprom_addr(direction, (*offset)++));
+
+    record.event.pressed = flags & 0x80;
+    record.event.type    = (flags >> 4) & 0x07;
+    record.event.key.col = eeprom_read_byte(dynamic_macro_eeprom_addr(direction, (*offset)++));
+    record.event.key.row = eeprom_read_byte(dynamic_macro_eeprom_addr(direction, (*offset)++));
+    if (flags & 0x08) {
+        uint8_t tap = eeprom_read_byte(dynamic_macro_eeprom_addr(direction, (*offset)++));
+#    ifndef NO_ACTION_TAPPING
+        record.tap.count       = tap >> 4;
+        record.tap.interrupted = tap & 0x01;
+#    else
+        (void)tap;
+#    endif
+    }
+    if (flags & 0x04) {
+        uint16_t keycode = eeprom_read_byte(dynamic_macro_eeprom_addr(direction, (*offset)++));
+        keycode |= eeprom_read_byte(dynamic_macro_eeprom_addr(direction, (*offset)++)) << 8;
+#    if defined(COMBO_ENABLE) || defined(REPEAT_KEY_ENABLE)
+        record.keycode = keycode;
+#    else
+        (void)keycode;
+#    endif
+    }
+    *delta = 0;
+    for (uint8_t i = 0; i < (flags & 0x03); i++) {
+        *delta |= eeprom_read_byte(dynamic_macro_eeprom_addr(direction, (*offset)++)) << (8 * i);
+    }
+    return record;
+}
+
+/**
+ * Start recording of the dynamic macro.
+ *
+ * The previous contents of the slot are dropped from the header right
+ * away, before any of its bytes get overwritten.
+ */
+static void dynamic_macro_record_start(int8_t direction) {
+    dprintln("dynamic macro recording: started");
+
+    dynamic_macro_record_start_user(direction);
+
+    clear_keyboard();
+    layer_clear();
+
+    dynamic_macro_eeprom_load();
+    macro_length[DYNAMIC_MACRO_SLOT(direction)] = 0;
+    dynamic_macro_eeprom_save();
+
+    record_length         = 0;
+    record_trimmed_length = 0;
+    record_last_time      = timer_read();
+    chunk_offset          = 0;
+    chunk_used            = 0;
+}
+
+/**
+ * Play the dynamic macro, reading it straight from EEPROM.
+ *
+ * Event times are rebuilt from the stored deltas, relative to the
+ * start of the playback.
+ */
+static void dynamic_macro_play(int8_t direction) {
+    dprintf("dynamic macro: slot %d playback\n", DYNAMIC_MACRO_CURRENT_SLOT());
+
+    dynamic_macro_eeprom_load();
+
+    layer_state_t saved_layer_state = layer_state;
+    uint16_t      length            = macro_length[DYNAMIC_MACRO_SLOT(direction)];
+    uint16_t      offset            = 0;
+    uint16_t      time              = timer_read();
+
+    clear_keyboard();
+    layer_clear();
+
+    while (offset < length) {
+        uint16_t    delta;
+        keyrecord_t record = dynamic_macro_event_decode(direction, &offset, &delta);
+        time += delta;
+        record.event.time = time;
+        process_record(&record);
+#    ifdef DYNAMIC_MACRO_DELAY
+        wait_ms(DYNAMIC_MACRO_DELAY);
+#    endif
+    }
+
+    clear_keyboard();
+
+    layer_state_set(saved_layer_state);
+
+    dynamic_macro_play_user(direction);
+}
+
+/**
+ * Record a single key in a dynamic macro, writing out the chunk once
+ * it is full. Events that do not fit next to the other macro are
+ * dropped.
+ */
+static void dynamic_macro_record_key(int8_t direction, keyrecord_t *record) {
+    /* If we've just started recording, ignore all the key releases. */
+    if (!record->event.pressed && record_length == 0) {
+        dprintln("dynamic macro: ignoring a leading key-up event");
+        return;
+    }
+
+    uint8_t  event[DYNAMIC_MACRO_EVENT_MAX_SIZE];
+    uint8_t  event_length = dynamic_macro_event_encode(event, record, record->event.time - record_last_time);
+    uint16_t capacity     = DYNAMIC_MACRO_EEPROM_DATA_SIZE - macro_length[DYNAMIC_MACRO_SLOT(-direction)];
+
+    if (record_length + event_length <= capacity) {
+        for (uint8_t i = 0; i < event_length; i++) {
+            if (chunk_used == sizeof(chunk)) {
+                dynamic_macro_chunk_flush(direction);
+            }
+            chunk[chunk_used++] = event[i];
+        }
+        record_length += event_length;
+        record_last_time = record->event.time;
+        if (!record->event.pressed) {
+            record_trimmed_length = record_length;
+        }
+    }
+    dynamic_macro_record_key_user(direction, record);
+
+    dprintf("dynamic macro: slot %d length: %u/%u bytes\n", DYNAMIC_MACRO_CURRENT_SLOT(), record_length, capacity);
+}
+
+/**
+ * End recording of the dynamic macro: write out the last chunk and
+ * store the new length in the header.
+ *
+ * Keys still held when stopping the recording, i.e. the keys used to
+ * access the layer DM_RSTP is on, are cut off the end of the macro.
+ */
+static void dynamic_macro_record_end(int8_t direction) {
+    dynamic_macro_record_end_user(direction);
+
+    dynamic_macro_chunk_flush(direction);
+
+    if (record_trimmed_length != record_length) {
+        dprintln("dynamic macro: trimming trailing key-down events");
+    }
+    macro_length[DYNAMIC_MACRO_SLOT(direction)] = record_trimmed_length;
+    dynamic_macro_eeprom_save();
+
+    dprintf("dynamic macro: slot %d saved, length: %u bytes\n", DYNAMIC_MACRO_CURRENT_SLOT(), record_trimmed_length);
+}
+
+/**
+ * If a dynamic macro is currently being recorded, stop recording.
+ */
+void dynamic_macro_stop_recording(void) {
+    switch (macro_id) {
+        case 1:
+            dynamic_macro_record_end(+1);
+            break;
+        case 2:
+            dynamic_macro_record_end(-1);
+            break;
+    }
+    macro_id = 0;
+}
+
+static void dynamic_macro_slot_record_start(uint8_t id) {
+    dynamic_macro_record_start(id == 1 ? +1 : -1);
+}
+
+static void dynamic_macro_slot_play(uint8_t id) {
+    dynamic_macro_play(id == 1 ? +1 : -1);
+}
+
+static void dynamic_macro_slot_record_key(uint8_t id, keyrecord_t *record) {
+    dynamic_macro_record_key(id == 1 ? +1 : -1, record);
+}
+
+#else
+
 /**
  * Start recording of the dynamic macro.
  *
@@ -220,6 +568,32 @@ void dynamic_macro_stop_recording(void) {
     macro_id = 0;
 }
 
+static void dynamic_macro_slot_record_start(uint8_t id) {
+    if (id == 1) {
+        dynamic_macro_record_start(&macro_pointer, macro_buffer, +1);
+    } else {
+        dynamic_macro_record_start(&macro_pointer, r_macro_buffer, -1);
+    }
+}
+
+static void dynamic_macro_slot_play(uint8_t id) {
+    if (id == 1) {
+        dynamic_macro_play(macro_buffer, macro_end, +1);
+    } else {
+        dynamic_macro_play(r_macro_buffer, r_macro_end, -1);
+    }
+}
+
+static void dynamic_macro_slot_record_key(uint8_t id, keyrecord_t *record) {
+    if (id == 1) {
+        dynamic_macro_record_key(macro_buffer, &macro_pointer, r_macro_end, +1, record);
+    } else {
+        dynamic_macro_record_key(r_macro_buffer, &macro_pointer, macro_end, -1, record);
+    }
+}
+
+#endif
+
 /* Handle the key events related to the dynamic macros. Should be
  * called from process_record_user() like this:
  *
@@ -236,18 +610,18 @@ bool process_dynamic_macro(uint16_t keycode, keyrecord_t *record) {
         if (!record->event.pressed) {
             switch (keycode) {
                 case QK_DYNAMIC_MACRO_RECORD_START_1:
-                    dynamic_macro_record_start(&macro_pointer, macro_buffer, +1);
+                    dynamic_macro_slot_record_start(1);
                     macro_id = 1;
                     return false;
                 case QK_DYNAMIC_MACRO_RECORD_START_2:
-                    dynamic_macro_record_start(&macro_pointer, r_macro_buffer, -1);
+                    dynamic_macro_slot_record_start(2);
                     macro_id = 2;
                     return false;
                 case QK_DYNAMIC_MACRO_PLAY_1:
-                    dynamic_macro_play(macro_buffer, macro_end, +1);
+                    dynamic_macro_slot_play(1);
                     return false;
                 case QK_DYNAMIC_MACRO_PLAY_2:
-                    dynamic_macro_play(r_macro_buffer, r_macro_end, -1);
+                    dynamic_macro_slot_play(2);
                     return false;
             }
         }
@@ -273,14 +647,7 @@ bool process_dynamic_macro(uint16_t keycode, keyrecord_t *record) {
             default:
                 if (dynamic_macro_valid_key_user(keycode, record)) {
                     /* Store the key in the macro buffer and process it normally. */
-                    switch (macro_id) {
-                        case 1:
-                            dynamic_macro_record_key(macro_buffer, &macro_pointer, r_macro_end, +1, record);
-                            break;
-                        case 2:
-                            dynamic_macro_record_key(r_macro_buffer, &macro_pointer, macro_end, -1, record);
-                            break;
-                    }
+                    dynamic_macro_slot_record_key(macro_id, record);
                 }
                 return true;
                 break;
@@ -35,6 +35,32 @@
 #    define DYNAMIC_MACRO_SIZE 128
 #endif
 
+#ifdef DYNAMIC_MACRO_EEPROM_STORAGE
+#    include "eeprom.h"
+
+/* Bytes of EEPROM shared by both macros, including a 6 byte header.
+ * Events are stored in a compact form of 3 to 8 bytes each, usually
+ * 4, so the default fits about 30 keypresses.
+ */
+#    ifndef DYNAMIC_MACRO_EEPROM_SIZE
+#        define DYNAMIC_MACRO_EEPROM_SIZE 256
+#    endif
+
+/* The macros live at the very end of the EEPROM unless told
+ * otherwise. Dynamic keymaps stop short of this address.
+ */
+#    ifndef DYNAMIC_MACRO_EEPROM_ADDR
+#        define DYNAMIC_MACRO_EEPROM_ADDR (TOTAL_EEPROM_BYTE_COUNT - DYNAMIC_MACRO_EEPROM_SIZE)
+#    endif
+
+/* Recorded events are gathered in RAM and written out this many
+ * bytes at a time.
+ */
+#    ifndef DYNAMIC_MACRO_EEPROM_CHUNK_SIZE
+#        define DYNAMIC_MACRO_EEPROM_CHUNK_SIZE 32
+#    endif
+#endif
+
 void dynamic_macro_led_blink(void);
 bool process_dynamic_macro(uint16_t keycode, keyrecord_t *record);
 void dynamic_macro_record_start_user(int8_t direction);
@@ -174,6 +174,7 @@ __attribute__((weak)) void post_process_record_user(uint16_t keycode, keyrecord_
 
 void shutdown_quantum(bool jump_to_bootloader) {
     clear_keyboard();
+    eeconfig_flush();
 #if defined(MIDI_ENABLE) && defined(MIDI_BASIC)
     process_midi_all_notes_off();
 #endif
@@ -253,12 +254,22 @@ bool pre_process_record_quantum(keyrecord_t *record) {
 /* Get keycode, and then call keyboard function */
 void post_process_record_quantum(keyrecord_t *record) {
     uint16_t keycode = get_record_keycode(record, false);
+#if defined(UNICODE_COMMON_ENABLE) && defined(UNICODEMAP_ASYNC)
+    unicode_async_action_end();
+#endif
     post_process_record_kb(keycode, record);
 }
 
 /* Core keycode function, hands off handling to other functions,
     then processes internal quantum keycodes, and then processes
     ACTIONs.                                                      */
+/* Handlers that only ever act on their own keycodes are guarded by that range
+ * here, so keys outside of it skip the call entirely instead of each handler
+ * declining them. Handlers that must see every key are called unconditionally,
+ * and the order of the chain is unchanged.
+ */
+#define PROCESS_KEYCODE_RANGE(in_range, handler) (!(in_range) || (handler))
+
 bool process_record_quantum(keyrecord_t *record) {
     uint16_t keycode = get_record_keycode(record, true);
 
@@ -325,19 +336,19 @@ bool process_record_quantum(keyrecord_t *record) {
             process_secure(keycode, record) &&
 #endif
 #if defined(SEQUENCER_ENABLE)
-            process_sequencer(keycode, record) &&
+            PROCESS_KEYCODE_RANGE(IS_QK_SEQUENCER(keycode), process_sequencer(keycode, record)) &&
 #endif
 #if defined(MIDI_ENABLE) && defined(MIDI_ADVANCED)
-            process_midi(keycode, record) &&
+            PROCESS_KEYCODE_RANGE(IS_QK_MIDI(keycode), process_midi(keycode, record)) &&
 #endif
 #ifdef AUDIO_ENABLE
-            process_audio(keycode, record) &&
+            PROCESS_KEYCODE_RANGE(IS_QK_AUDIO(keycode), process_audio(keycode, record)) &&
 #endif
 #if defined(BACKLIGHT_ENABLE) || defined(LED_MATRIX_ENABLE)
-            process_backlight(keycode, record) &&
+            PROCESS_KEYCODE_RANGE(IS_BACKLIGHT_KEYCODE(keycode), process_backlight(keycode, record)) &&
 #endif
 #ifdef STENO_ENABLE
-            process_steno(keycode, record) &&
+            PROCESS_KEYCODE_RANGE(IS_QK_STENO(keycode), process_steno(keycode, record)) &&
 #endif
 #if (defined(AUDIO_ENABLE) || (defined(MIDI_ENABLE) && defined(MIDI_BASIC))) && !defined(NO_MUSIC_MODE)
             process_music(keycode, record) &&
@@ -349,7 +360,7 @@ bool process_record_quantum(keyrecord_t *record) {
             process_key_override(keycode, record) &&
 #endif
 #ifdef TAP_DANCE_ENABLE
-            process_tap_dance(keycode, record) &&
+            PROCESS_KEYCODE_RANGE(IS_QK_TAP_DANCE(keycode), process_tap_dance(keycode, record)) &&
 #endif
 #if defined(UNICODE_COMMON_ENABLE)
             process_unicode_common(keycode, record) &&
@@ -361,31 +372,31 @@ bool process_record_quantum(keyrecord_t *record) {
             process_auto_shift(keycode, record) &&
 #endif
 #ifdef DYNAMIC_TAPPING_TERM_ENABLE
-            process_dynamic_tapping_term(keycode, record) &&
+            PROCESS_KEYCODE_RANGE(keycode >= QK_DYNAMIC_TAPPING_TERM_PRINT && keycode <= QK_DYNAMIC_TAPPING_TERM_DOWN, process_dynamic_tapping_term(keycode, record)) &&
 #endif
 #ifdef SPACE_CADET_ENABLE
             process_space_cadet(keycode, record) &&
 #endif
 #ifdef MAGIC_ENABLE
-            process_magic(keycode, record) &&
+            PROCESS_KEYCODE_RANGE(IS_MAGIC_KEYCODE(keycode), process_magic(keycode, record)) &&
 #endif
 #ifdef GRAVE_ESC_ENABLE
-            process_grave_esc(keycode, record) &&
+            PROCESS_KEYCODE_RANGE(keycode == QK_GRAVE_ESCAPE, process_grave_esc(keycode, record)) &&
 #endif
 #if defined(RGBLIGHT_ENABLE) || defined(RGB_MATRIX_ENABLE)
-            process_rgb(keycode, record) &&
+            PROCESS_KEYCODE_RANGE(IS_RGB_KEYCODE(keycode), process_rgb(keycode, record)) &&
 #endif
 #ifdef JOYSTICK_ENABLE
-            process_joystick(keycode, record) &&
+            PROCESS_KEYCODE_RANGE(IS_QK_JOYSTICK(keycode), process_joystick(keycode, record)) &&
 #endif
 #ifdef PROGRAMMABLE_BUTTON_ENABLE
-            process_programmable_button(keycode, record) &&
+            PROCESS_KEYCODE_RANGE(IS_QK_PROGRAMMABLE_BUTTON(keycode), process_programmable_button(keycode, record)) &&
 #endif
 #ifdef AUTOCORRECT_ENABLE
             process_autocorrect(keycode, record) &&
 #endif
 #ifdef TRI_LAYER_ENABLE
-            process_tri_layer(keycode, record) &&
+            PROCESS_KEYCODE_RANGE(keycode == QK_TRI_LAYER_LOWER || keycode == QK_TRI_LAYER_UPPER, process_tri_layer(keycode, record)) &&
 #endif
             true)) {
         return false;
@@ -476,7 +487,15 @@ bool process_record_quantum(keyrecord_t *record) {
         }
     }
 
-    return process_action_kb(record);
+    if (!process_action_kb(record)) {
+        return false;
+    }
+
+#if defined(UNICODE_COMMON_ENABLE) && defined(UNICODEMAP_ASYNC)
+    // Paired with unicode_async_action_end() in post_process_record_quantum(), which always follows the action
+    unicode_async_action_start();
+#endif
+    return true;
 }
 
 void set_single_persistent_default_layer(uint8_t default_layer) {
@@ -504,6 +523,10 @@ __attribute__((weak)) bool shutdown_kb(bool jump_to_bootloader) {
 
 void suspend_power_down_quantum(void) {
     suspend_power_down_kb();
+#ifdef EECONFIG_DEFER_COMMIT_MS
+    // The host may cut power while suspended
+    eeconfig_flush();
+#endif
 #ifndef NO_SUSPEND_POWER_DOWN
 // Turn off backlight
 #    ifdef BACKLIGHT_ENABLE
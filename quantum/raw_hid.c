@@ -0,0 +1,164 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "raw_hid.h"
+#include "ring_buffer.h"
+
+#ifdef VIA_ENABLE
+#    include "via.h"
+#endif
+
+#ifndef RAW_HID_ROUTE_COUNT
+#    define RAW_HID_ROUTE_COUNT 8
+#endif
+
+#ifndef RAW_HID_SEND_QUEUE_SIZE
+#    define RAW_HID_SEND_QUEUE_SIZE 4
+#endif
+
+#ifndef RAW_HID_RECEIVE_QUEUE_SIZE
+#    define RAW_HID_RECEIVE_QUEUE_SIZE 2
+#endif
+
+#define RAW_HID_REPORT_SIZE 32
+
+typedef struct {
+    uint8_t           first_id;
+    uint8_t           last_id;
+    raw_hid_handler_t handler;
+} raw_hid_route_t;
+
+typedef struct {
+    uint8_t length;
+    uint8_t data[RAW_HID_REPORT_SIZE];
+} raw_hid_packet_t;
+
+RING_BUFFER_DEFINE(raw_hid_packet_queue, raw_hid_packet_t, RAW_HID_SEND_QUEUE_SIZE);
+RING_BUFFER_DEFINE(raw_hid_command_queue, raw_hid_packet_t, RAW_HID_RECEIVE_QUEUE_SIZE);
+
+static raw_hid_route_t raw_hid_routes[RAW_HID_ROUTE_COUNT];
+static uint8_t         raw_hid_route_count = 0;
+
+static raw_hid_packet_queue_t  raw_hid_send_queue;
+static raw_hid_command_queue_t raw_hid_receive_queue;
+
+bool raw_hid_register_handler(uint8_t first_id, uint8_t last_id, raw_hid_handler_t handler) {
+    if (raw_hid_route_count >= RAW_HID_ROUTE_COUNT || first_id > last_id || handler == NULL) {
+        return false;
+    }
+    raw_hid_routes[raw_hid_route_count++] = (raw_hid_route_t){.first_id = first_id, .last_id = last_id, .handler = handler};
+    return true;
+}
+
+// Protocols that can tell whether the IN endpoint has room override this.
+__attribute__((weak)) bool raw_hid_send_ready(void) {
+    return true;
+}
+
+static bool raw_hid_packet_set(raw_hid_packet_t *packet, const uint8_t *data, uint8_t length) {
+    if (length > RAW_HID_REPORT_SIZE) {
+        return false;
+    }
+    memcpy(packet->data, data, length);
+    packet->length = length;
+    return true;
+}
+
+bool raw_hid_send_async(const uint8_t *data, uint8_t length) {
+    raw_hid_packet_t packet;
+    return raw_hid_packet_set(&packet, data, length) && raw_hid_packet_queue_push(&raw_hid_send_queue, packet);
+}
+
+// Sends every queued report, waiting on the host as raw_hid_send() does without the router
+static void raw_hid_send_all(void) {
+    raw_hid_packet_t packet;
+    while (raw_hid_packet_queue_pop(&raw_hid_send_queue, &packet)) {
+        raw_hid_send(packet.data, packet.length);
+    }
+}
+
+static void raw_hid_reply(uint8_t *data, uint8_t length) {
+    // Nothing ahead of it, send straight from the received buffer
+    if (raw_hid_packet_queue_empty(&raw_hid_send_queue) && raw_hid_send_ready()) {
+        raw_hid_send(data, length);
+        return;
+    }
+    // The host expects a reply to every command, so a full queue waits rather than drop it
+    if (raw_hid_packet_queue_full(&raw_hid_send_queue)) {
+        raw_hid_send_all();
+    }
+    raw_hid_send_async(data, length);
+}
+
+__attribute__((weak)) void raw_hid_receive_user(uint8_t *data, uint8_t length) {}
+
+__attribute__((weak)) void raw_hid_receive_kb(uint8_t *data, uint8_t length) {
+    raw_hid_receive_user(data, length);
+}
+
+static void raw_hid_dispatch(uint8_t *data, uint8_t length) {
+#ifdef VIA_ENABLE
+    // As without the router, the keyboard sees every command first, including routed ones
+    if (via_command_kb(data, length)) {
+        return;
+    }
+#endif
+
+    // Later registrations take precedence, so keyboard code can take over part of a core range
+    for (uint8_t i = raw_hid_route_count; i > 0; i--) {
+        const raw_hid_route_t *route = &raw_hid_routes[i - 1];
+        if (data[0] >= route->first_id && data[0] <= route->last_id) {
+            if (route->handler(data, length)) {
+                raw_hid_reply(data, length);
+            }
+            return;
+        }
+    }
+
+#ifdef VIA_ENABLE
+    // VIA hosts wait for a reply to every command, unknown ones are echoed back as unhandled
+    data[0] = id_unhandled;
+    raw_hid_reply(data, length);
+#else
+    raw_hid_receive_kb(data, length);
+#endif
+}
+
+static void raw_hid_send_pending(void) {
+    raw_hid_packet_t packet;
+    while (raw_hid_send_ready() && raw_hid_packet_queue_pop(&raw_hid_send_queue, &packet)) {
+        raw_hid_send(packet.data, packet.length);
+    }
+}
+
+void raw_hid_receive(uint8_t *data, uint8_t length) {
+    raw_hid_send_pending();
+    if (raw_hid_packet_queue_empty(&raw_hid_send_queue) && raw_hid_command_queue_empty(&raw_hid_receive_queue)) {
+        raw_hid_dispatch(data, length);
+        return;
+    }
+
+    // Handlers may call raw_hid_send() themselves, so a command waits until the reports ahead of it are sent
+    raw_hid_packet_t packet;
+    if (raw_hid_packet_set(&packet, data, length) && raw_hid_command_queue_push(&raw_hid_receive_queue, packet)) {
+        return;
+    }
+
+    // No room left, catch up by waiting on the host instead of dropping the command
+    raw_hid_send_all();
+    while (raw_hid_command_queue_pop(&raw_hid_receive_queue, &packet)) {
+        raw_hid_dispatch(packet.data, packet.length);
+        raw_hid_send_all();
+    }
+    raw_hid_dispatch(data, length);
+}
+
+void raw_hid_router_task(void) {
+    raw_hid_packet_t packet;
+    raw_hid_send_pending();
+    while (raw_hid_packet_queue_empty(&raw_hid_send_queue) && raw_hid_command_queue_pop(&raw_hid_receive_queue, &packet)) {
+        raw_hid_dispatch(packet.data, packet.length);
+        raw_hid_send_pending();
+    }
+}
@@ -28,4 +28,57 @@ void raw_hid_receive(uint8_t *data, uint8_t length);
  */
 void raw_hid_send(uint8_t *data, uint8_t length);
 
+#if defined(RAW_HID_ROUTER_ENABLE) || defined(__DOXYGEN__)
+#    include <stdbool.h>
+
+/**
+ * \brief Handler for a range of command IDs, the first byte of the received report.
+ *
+ * The received report is passed in place, and can be overwritten with the response.
+ *
+ * \param data A pointer to the received data.
+ * \param length The length of the buffer.
+ *
+ * \return `true` to send `data` back to the host as the response, `false` if the handler queued its own response, or sends none.
+ */
+typedef bool (*raw_hid_handler_t)(uint8_t *data, uint8_t length);
+
+/**
+ * \brief Route reports with a command ID from `first_id` to `last_id` inclusive to a handler.
+ *
+ * When ranges overlap, the handler registered last is used.
+ *
+ * \return `true` if the handler was registered, `false` if there is no free route left.
+ */
+bool raw_hid_register_handler(uint8_t first_id, uint8_t last_id, raw_hid_handler_t handler);
+
+/**
+ * \brief Queue an HID report to be sent without waiting for the host.
+ *
+ * The report is copied, so a handler can queue several reports from the same buffer to build a multi-packet response.
+ *
+ * \param data A pointer to the data to send.
+ * \param length The length of the buffer, at most 32.
+ *
+ * \return `true` if the report was queued, `false` if the queue is full.
+ */
+bool raw_hid_send_async(const uint8_t *data, uint8_t length);
+
+/**
+ * \brief Whether `raw_hid_send()` can be called without waiting for the host.
+ */
+bool raw_hid_send_ready(void);
+
+/**
+ * \brief Callback, invoked for received reports that no registered handler accepts. Not used with VIA, which answers them with `id_unhandled`.
+ */
+void raw_hid_receive_kb(uint8_t *data, uint8_t length);
+void raw_hid_receive_user(uint8_t *data, uint8_t length);
+
+/**
+ * \brief Sends the queued reports the host has room for, then handles the commands that were waiting for them. Called from the main loop, should not be invoked by keyboard/user code.
+ */
+void raw_hid_router_task(void);
+#endif
+
 /** \} */
@@ -29,16 +29,61 @@
 
 #include <lib/lib8tion/lib8tion.h>
 
+#ifdef RGB_MATRIX_SKIP_STATIC_FRAMES
+#    include "action_layer.h"
+#    include "action_util.h"
+#    include "host.h"
+#endif
+
 #ifndef RGB_MATRIX_CENTER
 const led_point_t k_rgb_matrix_center = {112, 32};
 #else
 const led_point_t k_rgb_matrix_center = RGB_MATRIX_CENTER;
 #endif
 
+// Distance and angle of each LED from the center, computed once at init for effects that are polar in nature
+#ifdef RGB_MATRIX_POLAR_EFFECTS
+led_polar_t g_led_polar[RGB_MATRIX_LED_COUNT];
+#endif
+
 __attribute__((weak)) RGB rgb_matrix_hsv_to_rgb(HSV hsv) {
     return hsv_to_rgb(hsv);
 }
 
+// Keyboards that override rgb_matrix_hsv_to_rgb() need to override this as well
+__attribute__((weak)) void rgb_matrix_hsv_to_rgb_batch(const uint8_t *h, const uint8_t *s, const uint8_t *v, uint8_t *r, uint8_t *g, uint8_t *b, uint8_t count) {
+    hsv_to_rgb_batch(h, s, v, r, g, b, count);
+}
+
+// Colors computed by an effect runner, one array per channel, converted to RGB together
+static struct {
+    uint8_t count;
+    uint8_t index[RGB_MATRIX_HSV_BATCH_SIZE];
+    uint8_t h[RGB_MATRIX_HSV_BATCH_SIZE];
+    uint8_t s[RGB_MATRIX_HSV_BATCH_SIZE];
+    uint8_t v[RGB_MATRIX_HSV_BATCH_SIZE];
+} rgb_matrix_hsv_batch;
+
+static void rgb_matrix_flush_hsv_batch(void) {
+    // Converted in place, h, s and v then hold r, g and b
+    rgb_matrix_hsv_to_rgb_batch(rgb_matrix_hsv_batch.h, rgb_matrix_hsv_batch.s, rgb_matrix_hsv_batch.v, rgb_matrix_hsv_batch.h, rgb_matrix_hsv_batch.s, rgb_matrix_hsv_batch.v, rgb_matrix_hsv_batch.count);
+    for (uint8_t i = 0; i < rgb_matrix_hsv_batch.count; i++) {
+        rgb_matrix_set_color(rgb_matrix_hsv_batch.index[i], rgb_matrix_hsv_batch.h[i], rgb_matrix_hsv_batch.s[i], rgb_matrix_hsv_batch.v[i]);
+    }
+    rgb_matrix_hsv_batch.count = 0;
+}
+
+static void rgb_matrix_set_hsv_batched(uint8_t index, HSV hsv) {
+    uint8_t i                     = rgb_matrix_hsv_batch.count++;
+    rgb_matrix_hsv_batch.index[i] = index;
+    rgb_matrix_hsv_batch.h[i]     = hsv.h;
+    rgb_matrix_hsv_batch.s[i]     = hsv.s;
+    rgb_matrix_hsv_batch.v[i]     = hsv.v;
+    if (rgb_matrix_hsv_batch.count == RGB_MATRIX_HSV_BATCH_SIZE) {
+        rgb_matrix_flush_hsv_batch();
+    }
+}
+
 // Generic effect runners
 #include "rgb_matrix_runners.inc"
 
@@ -77,6 +122,33 @@ static uint8_t         rgb_last_effect   = UINT8_MAX;
 static effect_params_t rgb_effect_params = {0, LED_FLAG_ALL, false};
 static rgb_task_states rgb_task_state    = SYNCING;
 
+#ifdef RGB_MATRIX_ADAPTIVE_TIMING
+// Number of LEDs rendered per task run and minimum frame interval, adjusted after each frame
+static uint8_t  rgb_process_limit  = (RGB_MATRIX_LED_PROCESS_LIMIT > 0 && RGB_MATRIX_LED_PROCESS_LIMIT < RGB_MATRIX_LED_COUNT) ? RGB_MATRIX_LED_PROCESS_LIMIT : RGB_MATRIX_LED_COUNT;
+static uint16_t rgb_flush_interval = RGB_MATRIX_LED_FLUSH_LIMIT;
+static uint32_t rgb_frame_start;
+static uint16_t rgb_frame_task_calls;
+// Main loop rate between frames, while nothing is rendered, so the target never exceeds what the board can do
+static uint32_t rgb_idle_start;
+static uint32_t rgb_idle_task_calls;
+static uint32_t rgb_baseline_scan_rate = 0;
+#    define RGB_MATRIX_CURRENT_PROCESS_LIMIT rgb_process_limit
+#    define RGB_MATRIX_CURRENT_FLUSH_LIMIT rgb_flush_interval
+#else
+#    define RGB_MATRIX_CURRENT_PROCESS_LIMIT RGB_MATRIX_LED_PROCESS_LIMIT
+#    define RGB_MATRIX_CURRENT_FLUSH_LIMIT RGB_MATRIX_LED_FLUSH_LIMIT
+#endif // RGB_MATRIX_ADAPTIVE_TIMING
+
+#ifdef RGB_MATRIX_SKIP_STATIC_FRAMES
+// State that the last flushed frame of a static effect was rendered from
+static bool          rgb_static_frame_valid = false;
+static rgb_config_t  rgb_static_frame_config;
+static layer_state_t rgb_static_frame_layer_state;
+static layer_state_t rgb_static_frame_default_layer_state;
+static uint8_t       rgb_static_frame_led_state;
+static uint8_t       rgb_static_frame_mods;
+#endif // RGB_MATRIX_SKIP_STATIC_FRAMES
+
 // double buffers
 static uint32_t rgb_timer_buffer;
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
@@ -258,16 +330,85 @@ static void rgb_task_timers(void) {
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 }
 
-static void rgb_task_sync(void) {
+#ifdef RGB_MATRIX_SKIP_STATIC_FRAMES
+static bool rgb_matrix_is_static_effect(uint8_t effect) {
+    return effect == RGB_MATRIX_NONE || effect == RGB_MATRIX_SOLID_COLOR;
+}
+
+// Returns true if the effect is static and none of the state that it or the basic indicators depend on has changed since the last flush
+static bool rgb_matrix_static_frame_unchanged(uint8_t effect) {
+    return rgb_static_frame_valid && rgb_matrix_is_static_effect(effect) && rgb_static_frame_config.raw == rgb_matrix_config.raw && rgb_static_frame_layer_state == layer_state && rgb_static_frame_default_layer_state == default_layer_state && rgb_static_frame_led_state == host_keyboard_led_state().raw && rgb_static_frame_mods == get_mods();
+}
+
+static void rgb_matrix_store_static_frame(uint8_t effect) {
+    rgb_static_frame_valid               = rgb_matrix_is_static_effect(effect);
+    rgb_static_frame_config              = rgb_matrix_config;
+    rgb_static_frame_layer_state         = layer_state;
+    rgb_static_frame_default_layer_state = default_layer_state;
+    rgb_static_frame_led_state           = host_keyboard_led_state().raw;
+    rgb_static_frame_mods                = get_mods();
+}
+#endif // RGB_MATRIX_SKIP_STATIC_FRAMES
+
+#ifdef RGB_MATRIX_ADAPTIVE_TIMING
+static void rgb_task_adapt_timing(void) {
+    uint32_t elapsed = timer_elapsed32(rgb_frame_start);
+    // Approximate main loop rate while this frame was being rendered and flushed
+    uint32_t loop_rate = elapsed > 0 ? (uint32_t)rgb_frame_task_calls * 1000 / elapsed : UINT32_MAX;
+    // Nothing is throttled until a baseline has been measured, and only rendering's share of the scan rate is won back
+    uint32_t target = MIN(RGB_MATRIX_TARGET_SCAN_RATE, rgb_baseline_scan_rate - rgb_baseline_scan_rate / 4);
+
+    if (loop_rate < target) {
+        // Rendering is costing scan rate -- render fewer LEDs per task run, then fall back to a lower frame rate
+        if (rgb_process_limit > 1) {
+            rgb_process_limit -= (rgb_process_limit >= 4) ? rgb_process_limit / 4 : 1;
+        } else if (rgb_flush_interval < RGB_MATRIX_LED_FLUSH_LIMIT_MAX) {
+            rgb_flush_interval++;
+        }
+    } else if (loop_rate > target + target / 4) {
+        // Plenty of headroom -- restore the frame rate first, then render more LEDs per task run if frames are running long
+        if (rgb_flush_interval > RGB_MATRIX_LED_FLUSH_LIMIT) {
+            rgb_flush_interval--;
+        } else if (elapsed >= rgb_flush_interval && rgb_process_limit < RGB_MATRIX_LED_COUNT) {
+            rgb_process_limit++;
+        }
+    }
+}
+#endif // RGB_MATRIX_ADAPTIVE_TIMING
+
+static void rgb_task_sync(uint8_t effect) {
     eeconfig_flush_rgb_matrix(false);
+#ifdef RGB_MATRIX_SKIP_STATIC_FRAMES
+    // Nothing to redraw for static effects until something they depend on changes
+    if (rgb_matrix_static_frame_unchanged(effect) && effect == rgb_last_effect && rgb_matrix_config.enable == rgb_last_enable) {
+        return;
+    }
+#endif // RGB_MATRIX_SKIP_STATIC_FRAMES
     // next task
-    if (sync_timer_elapsed32(g_rgb_timer) >= RGB_MATRIX_LED_FLUSH_LIMIT) rgb_task_state = STARTING;
+    if (sync_timer_elapsed32(g_rgb_timer) >= RGB_MATRIX_CURRENT_FLUSH_LIMIT) rgb_task_state = STARTING;
+}
+
+#ifdef RGB_MATRIX_ADAPTIVE_TIMING
+static void rgb_measure_idle_scan_rate(void) {
+    uint32_t idle_elapsed = timer_elapsed32(rgb_idle_start);
+    if (idle_elapsed > 0 && rgb_idle_task_calls > 0) {
+        rgb_baseline_scan_rate = rgb_idle_task_calls * 1000 / idle_elapsed;
+    }
+    rgb_idle_start      = timer_read32();
+    rgb_idle_task_calls = 0;
 }
+#endif // RGB_MATRIX_ADAPTIVE_TIMING
 
 static void rgb_task_start(void) {
     // reset iter
     rgb_effect_params.iter = 0;
 
+#ifdef RGB_MATRIX_ADAPTIVE_TIMING
+    rgb_measure_idle_scan_rate();
+    rgb_frame_start      = timer_read32();
+    rgb_frame_task_calls = 0;
+#endif // RGB_MATRIX_ADAPTIVE_TIMING
+
     // update double buffers
     g_rgb_timer = rgb_timer_buffer;
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
@@ -346,6 +487,15 @@ static void rgb_task_flush(uint8_t effect) {
     // update pwm buffers
     rgb_matrix_update_pwm_buffers();
 
+#ifdef RGB_MATRIX_SKIP_STATIC_FRAMES
+    rgb_matrix_store_static_frame(effect);
+#endif // RGB_MATRIX_SKIP_STATIC_FRAMES
+#ifdef RGB_MATRIX_ADAPTIVE_TIMING
+    rgb_task_adapt_timing();
+    rgb_idle_start      = timer_read32();
+    rgb_idle_task_calls = 0;
+#endif // RGB_MATRIX_ADAPTIVE_TIMING
+
     // next task
     rgb_task_state = SYNCING;
 }
@@ -363,6 +513,17 @@ void rgb_matrix_task(void) {
 
     uint8_t effect = suspend_backlight || !rgb_matrix_config.enable ? 0 : rgb_matrix_config.mode;
 
+#ifdef RGB_MATRIX_ADAPTIVE_TIMING
+    if (rgb_task_state == RENDERING || rgb_task_state == FLUSHING) {
+        rgb_frame_task_calls++;
+    } else if (rgb_task_state == SYNCING) {
+        // A long idle stretch, e.g. while suspended, is measured in parts so that the rate cannot overflow
+        if (++rgb_idle_task_calls >= UINT32_MAX / 1000) {
+            rgb_measure_idle_scan_rate();
+        }
+    }
+#endif // RGB_MATRIX_ADAPTIVE_TIMING
+
     switch (rgb_task_state) {
         case STARTING:
             rgb_task_start();
@@ -380,7 +541,7 @@ void rgb_matrix_task(void) {
             rgb_task_flush(effect);
             break;
         case SYNCING:
-            rgb_task_sync();
+            rgb_task_sync(effect);
             break;
     }
 }
@@ -399,17 +560,17 @@ __attribute__((weak)) bool rgb_matrix_indicators_user(void) {
 
 struct rgb_matrix_limits_t rgb_matrix_get_limits(uint8_t iter) {
     struct rgb_matrix_limits_t limits = {0};
-#if defined(RGB_MATRIX_LED_PROCESS_LIMIT) && RGB_MATRIX_LED_PROCESS_LIMIT > 0 && RGB_MATRIX_LED_PROCESS_LIMIT < RGB_MATRIX_LED_COUNT
+#if defined(RGB_MATRIX_ADAPTIVE_TIMING) || (defined(RGB_MATRIX_LED_PROCESS_LIMIT) && RGB_MATRIX_LED_PROCESS_LIMIT > 0 && RGB_MATRIX_LED_PROCESS_LIMIT < RGB_MATRIX_LED_COUNT)
 #    if defined(RGB_MATRIX_SPLIT)
-    limits.led_min_index = RGB_MATRIX_LED_PROCESS_LIMIT * (iter);
-    limits.led_max_index = limits.led_min_index + RGB_MATRIX_LED_PROCESS_LIMIT;
+    limits.led_min_index = RGB_MATRIX_CURRENT_PROCESS_LIMIT * (iter);
+    limits.led_max_index = limits.led_min_index + RGB_MATRIX_CURRENT_PROCESS_LIMIT;
     if (limits.led_max_index > RGB_MATRIX_LED_COUNT) limits.led_max_index = RGB_MATRIX_LED_COUNT;
     uint8_t k_rgb_matrix_split[2] = RGB_MATRIX_SPLIT;
     if (is_keyboard_left() && (limits.led_max_index > k_rgb_matrix_split[0])) limits.led_max_index = k_rgb_matrix_split[0];
     if (!(is_keyboard_left()) && (limits.led_min_index < k_rgb_matrix_split[0])) limits.led_min_index = k_rgb_matrix_split[0];
 #    else
-    limits.led_min_index = RGB_MATRIX_LED_PROCESS_LIMIT * (iter);
-    limits.led_max_index = limits.led_min_index + RGB_MATRIX_LED_PROCESS_LIMIT;
+    limits.led_min_index = RGB_MATRIX_CURRENT_PROCESS_LIMIT * (iter);
+    limits.led_max_index = limits.led_min_index + RGB_MATRIX_CURRENT_PROCESS_LIMIT;
     if (limits.led_max_index > RGB_MATRIX_LED_COUNT) limits.led_max_index = RGB_MATRIX_LED_COUNT;
 #    endif
 #else
@@ -448,6 +609,15 @@ __attribute__((weak)) bool rgb_matrix_indicators_advanced_user(uint8_t led_min,
 void rgb_matrix_init(void) {
     rgb_matrix_driver.init();
 
+#ifdef RGB_MATRIX_POLAR_EFFECTS
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        int16_t dx           = g_led_config.point[i].x - k_rgb_matrix_center.x;
+        int16_t dy           = g_led_config.point[i].y - k_rgb_matrix_center.y;
+        g_led_polar[i].dist  = sqrt16(dx * dx + dy * dy);
+        g_led_polar[i].angle = atan2_8(dy, dx);
+    }
+#endif
+
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
     g_last_hit_tracker.count = 0;
     for (uint8_t i = 0; i < LED_HITS_TO_REMEMBER; ++i) {
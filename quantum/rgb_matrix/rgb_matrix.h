@@ -90,6 +90,19 @@
 #    define RGB_MATRIX_LED_PROCESS_LIMIT ((RGB_MATRIX_LED_COUNT + 4) / 5)
 #endif
 
+#ifndef RGB_MATRIX_HSV_BATCH_SIZE
+#    define RGB_MATRIX_HSV_BATCH_SIZE 16
+#endif
+
+#ifdef RGB_MATRIX_ADAPTIVE_TIMING
+#    ifndef RGB_MATRIX_TARGET_SCAN_RATE
+#        define RGB_MATRIX_TARGET_SCAN_RATE 1000
+#    endif
+#    ifndef RGB_MATRIX_LED_FLUSH_LIMIT_MAX
+#        define RGB_MATRIX_LED_FLUSH_LIMIT_MAX (RGB_MATRIX_LED_FLUSH_LIMIT * 4)
+#    endif
+#endif
+
 struct rgb_matrix_limits_t {
     uint8_t led_min_index;
     uint8_t led_max_index;
@@ -271,6 +284,9 @@ extern rgb_config_t rgb_matrix_config;
 
 extern uint32_t     g_rgb_timer;
 extern led_config_t g_led_config;
+#ifdef RGB_MATRIX_POLAR_EFFECTS
+extern led_polar_t g_led_polar[RGB_MATRIX_LED_COUNT];
+#endif
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
 extern last_hit_t g_last_hit_tracker;
 #endif
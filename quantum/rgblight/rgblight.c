@@ -126,6 +126,17 @@ rgblight_segment_t const *const *rgblight_layers = NULL;
 static bool deferred_set_layer_state = false;
 #endif
 
+#ifdef RGBLIGHT_FRAME_DIFF
+static rgb_led_t last_frame[RGBLIGHT_LED_COUNT];
+static uint8_t   frame_start_pos;
+static uint8_t   frame_num_leds;
+static bool      frame_valid = false;
+#    ifdef RGBLIGHT_SPLIT
+static rgblight_syncinfo_t last_sync;
+static bool                sync_valid = false;
+#    endif
+#endif
+
 rgblight_ranges_t rgblight_ranges = {0, RGBLIGHT_LED_COUNT, 0, RGBLIGHT_LED_COUNT, RGBLIGHT_LED_COUNT};
 
 void rgblight_set_clipping_range(uint8_t start_pos, uint8_t num_leds) {
@@ -180,7 +191,7 @@ void rgblight_check_config(void) {
 
 uint64_t eeconfig_read_rgblight(void) {
 #ifdef EEPROM_ENABLE
-    return (uint64_t)((eeprom_read_dword(EECONFIG_RGBLIGHT)) | ((uint64_t)eeprom_read_byte(EECONFIG_RGBLIGHT_EXTENDED) << 32));
+    return (uint64_t)((eeconfig_read_dword(EECONFIG_RGBLIGHT)) | ((uint64_t)eeconfig_read_byte(EECONFIG_RGBLIGHT_EXTENDED) << 32));
 #else
     return 0;
 #endif
@@ -189,8 +200,8 @@ uint64_t eeconfig_read_rgblight(void) {
 void eeconfig_update_rgblight(uint64_t val) {
 #ifdef EEPROM_ENABLE
     rgblight_check_config();
-    eeprom_update_dword(EECONFIG_RGBLIGHT, val & 0xFFFFFFFF);
-    eeprom_update_byte(EECONFIG_RGBLIGHT_EXTENDED, (val >> 32) & 0xFF);
+    eeconfig_update_dword(EECONFIG_RGBLIGHT, val & 0xFFFFFFFF);
+    eeconfig_update_byte(EECONFIG_RGBLIGHT_EXTENDED, (val >> 32) & 0xFF);
 #endif
 }
 
@@ -878,6 +889,10 @@ void rgblight_suspend(void) {
 
 void rgblight_wakeup(void) {
     is_suspended = false;
+#    ifdef RGBLIGHT_FRAME_DIFF
+    // LEDs may have lost power while suspended; resend the whole strip
+    rgblight_invalidate_frame();
+#    endif
 
     if (pre_suspend_enabled) {
         rgblight_enable_noeeprom();
@@ -936,9 +951,34 @@ void rgblight_set(void) {
         convert_rgb_to_rgbw(&start_led[i]);
     }
 #endif
+#ifdef RGBLIGHT_FRAME_DIFF
+    // The LED chain latches whatever it is sent, so only the prefix up to the
+    // last LED that differs from the previous frame needs to go out again.
+    uint8_t send_leds = num_leds;
+    if (frame_valid && frame_start_pos == rgblight_ranges.clipping_start_pos && frame_num_leds == num_leds) {
+        while (send_leds > 0 && memcmp(&start_led[send_leds - 1], &last_frame[send_leds - 1], sizeof(rgb_led_t)) == 0) {
+            send_leds--;
+        }
+        if (send_leds == 0) {
+            return;
+        }
+    }
+    memcpy(last_frame, start_led, send_leds * sizeof(rgb_led_t));
+    frame_start_pos = rgblight_ranges.clipping_start_pos;
+    frame_num_leds  = num_leds;
+    frame_valid     = true;
+    rgblight_driver.setleds(start_led, send_leds);
+#else
     rgblight_driver.setleds(start_led, num_leds);
+#endif
 }
 
+#ifdef RGBLIGHT_FRAME_DIFF
+void rgblight_invalidate_frame(void) {
+    frame_valid = false;
+}
+#endif
+
 #ifdef RGBLIGHT_SPLIT
 /* for split keyboard master side */
 uint8_t rgblight_get_change_flags(void) {
@@ -946,10 +986,31 @@ uint8_t rgblight_get_change_flags(void) {
 }
 
 void rgblight_clear_change_flags(void) {
+#    ifdef RGBLIGHT_FRAME_DIFF
+    last_sync.config = rgblight_config;
+    last_sync.status = rgblight_status;
+    sync_valid       = true;
+#    endif
     rgblight_status.change_flags = 0;
 }
 
 void rgblight_get_syncinfo(rgblight_syncinfo_t *syncinfo) {
+#    ifdef RGBLIGHT_FRAME_DIFF
+    // Drop HSV and layer change flags whose payload matches what the slave last
+    // received, so redundant refreshes do not cost a split transfer. Mode and
+    // timer changes are always sent: setting the same mode again restarts the
+    // animation, and the slave has to restart with it to stay in step.
+    if (sync_valid) {
+        if (rgblight_config.hue == last_sync.config.hue && rgblight_config.sat == last_sync.config.sat && rgblight_config.val == last_sync.config.val) {
+            rgblight_status.change_flags &= ~RGBLIGHT_STATUS_CHANGE_HSVS;
+        }
+#        ifdef RGBLIGHT_LAYERS
+        if (rgblight_status.enabled_layer_mask == last_sync.status.enabled_layer_mask) {
+            rgblight_status.change_flags &= ~RGBLIGHT_STATUS_CHANGE_LAYERS;
+        }
+#        endif
+    }
+#    endif
     syncinfo->config = rgblight_config;
     syncinfo->status = rgblight_status;
 }
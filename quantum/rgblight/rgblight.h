@@ -298,6 +298,10 @@ void setrgb(uint8_t r, uint8_t g, uint8_t b, rgb_led_t *led1);
 /* === Low level Functions === */
 void rgblight_set(void);
 void rgblight_set_clipping_range(uint8_t start_pos, uint8_t num_leds);
+#ifdef RGBLIGHT_FRAME_DIFF
+/* Force the next rgblight_set() to resend every LED, e.g. after the strip lost power */
+void rgblight_invalidate_frame(void);
+#endif
 
 /* === Effects and Animations Functions === */
 /*   effect range setting */
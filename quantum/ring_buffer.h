@@ -1,48 +1,109 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
 #pragma once
 
+/*
+ * Typed single-producer/single-consumer ring buffers.
+ *
+ *   RING_BUFFER_DEFINE(event_queue, my_event_t, 16);
+ *
+ *   static event_queue_t queue;            // zero-initialised is empty
+ *   event_queue_push(&queue, event);       // producer side, e.g. an ISR
+ *   while (event_queue_pop(&queue, &event)) // consumer side, e.g. a task
+ *   event_queue_clear(&queue);             // consumer side only
+ *
+ * Head and tail are free-running counters of the index type, masked with (size - 1)
+ * when addressing the buffer, so size must be a power of two and at most half the
+ * range of the index type. The producer only ever writes head and the consumer only
+ * ever writes tail; each side publishes its index with release semantics after the
+ * buffer slot has been written or read. AVR cannot access more than a byte at once,
+ * so there the indices are accessed with interrupts masked instead.
+ */
+
 #include <stdint.h>
 #include <stdbool.h>
-#include "atomic_util.h"
 
-#ifndef RBUF_SIZE
-#    define RBUF_SIZE 32
+#ifdef __cplusplus
+#    define RING_BUFFER_STATIC_ASSERT static_assert
+#else
+#    define RING_BUFFER_STATIC_ASSERT _Static_assert
+#endif
+
+#if defined(__AVR__)
+#    include "atomic_util.h"
+#    define RING_BUFFER_LOAD_ACQUIRE(ptr)                 \
+        __extension__({                                   \
+            __typeof__(*(ptr)) ring_buffer_value;         \
+            ATOMIC_BLOCK_RESTORESTATE {                   \
+                ring_buffer_value = *(ptr);               \
+            }                                             \
+            ring_buffer_value;                            \
+        })
+#    define RING_BUFFER_STORE_RELEASE(ptr, value) \
+        do {                                      \
+            ATOMIC_BLOCK_RESTORESTATE {           \
+                *(ptr) = (value);                 \
+            }                                     \
+        } while (0)
+#else
+#    define RING_BUFFER_LOAD_ACQUIRE(ptr) __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+#    define RING_BUFFER_STORE_RELEASE(ptr, value) __atomic_store_n((ptr), (value), __ATOMIC_RELEASE)
 #endif
 
-static uint8_t     rbuf[RBUF_SIZE];
-static uint8_t     rbuf_head = 0;
-static uint8_t     rbuf_tail = 0;
-static inline bool rbuf_enqueue(uint8_t data) {
-    bool ret = false;
-    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
-        uint8_t next = (rbuf_head + 1) % RBUF_SIZE;
-        if (next != rbuf_tail) {
-            rbuf[rbuf_head] = data;
-            rbuf_head       = next;
-            ret             = true;
-        }
-    }
-    return ret;
-}
-static inline uint8_t rbuf_dequeue(void) {
-    uint8_t val = 0;
-    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
-        if (rbuf_head != rbuf_tail) {
-            val       = rbuf[rbuf_tail];
-            rbuf_tail = (rbuf_tail + 1) % RBUF_SIZE;
-        }
-    }
+// clang-format off
+#define RING_BUFFER_DEFINE_INDEXED(name, type, size, index_type)                                                       \
+    typedef struct {                                                                                                   \
+        index_type head;                                                                                               \
+        index_type tail;                                                                                               \
+        type       buffer[size];                                                                                       \
+    } name##_t;                                                                                                        \
+                                                                                                                       \
+    static inline void name##_clear(name##_t *queue) {                                                                 \
+        RING_BUFFER_STORE_RELEASE(&queue->tail, RING_BUFFER_LOAD_ACQUIRE(&queue->head));                               \
+    }                                                                                                                  \
+                                                                                                                       \
+    static inline index_type name##_count(name##_t *queue) {                                                           \
+        return (index_type)(RING_BUFFER_LOAD_ACQUIRE(&queue->head) - RING_BUFFER_LOAD_ACQUIRE(&queue->tail));          \
+    }                                                                                                                  \
+                                                                                                                       \
+    static inline bool name##_empty(name##_t *queue) {                                                                 \
+        return name##_count(queue) == 0;                                                                               \
+    }                                                                                                                  \
+                                                                                                                       \
+    static inline bool name##_full(name##_t *queue) {                                                                  \
+        return name##_count(queue) >= (size);                                                                          \
+    }                                                                                                                  \
+                                                                                                                       \
+    static inline bool name##_push(name##_t *queue, type item) {                                                       \
+        index_type head = queue->head;                                                                                 \
+        if ((index_type)(head - RING_BUFFER_LOAD_ACQUIRE(&queue->tail)) >= (size)) {                                   \
+            return false;                                                                                              \
+        }                                                                                                              \
+        queue->buffer[head & ((size) - 1)] = item;                                                                     \
+        RING_BUFFER_STORE_RELEASE(&queue->head, (index_type)(head + 1));                                               \
+        return true;                                                                                                   \
+    }                                                                                                                  \
+                                                                                                                       \
+    static inline bool name##_peek(name##_t *queue, type *item) {                                                      \
+        index_type tail = queue->tail;                                                                                 \
+        if (RING_BUFFER_LOAD_ACQUIRE(&queue->head) == tail) {                                                          \
+            return false;                                                                                              \
+        }                                                                                                              \
+        *item = queue->buffer[tail & ((size) - 1)];                                                                    \
+        return true;                                                                                                   \
+    }                                                                                                                  \
+                                                                                                                       \
+    static inline bool name##_pop(name##_t *queue, type *item) {                                                       \
+        if (!name##_peek(queue, item)) {                                                                               \
+            return false;                                                                                              \
+        }                                                                                                              \
+        RING_BUFFER_STORE_RELEASE(&queue->tail, (index_type)(queue->tail + 1));                                        \
+        return true;                                                                                                   \
+    }                                                                                                                  \
+                                                                                                                       \
+    RING_BUFFER_STATIC_ASSERT((size) > 0 && ((size) & ((size) - 1)) == 0, #name " size must be a power of two");     \
+    RING_BUFFER_STATIC_ASSERT((size) <= (((index_type)~(index_type)0) / 2 + 1), #name " size too large for index type")
+// clang-format on
 
-    return val;
-}
-static inline bool rbuf_has_data(void) {
-    bool has_data;
-    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
-        has_data = (rbuf_head != rbuf_tail);
-    }
-    return has_data;
-}
-static inline void rbuf_clear(void) {
-    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
-        rbuf_head = rbuf_tail = 0;
-    }
-}
+#define RING_BUFFER_DEFINE(name, type, size) RING_BUFFER_DEFINE_INDEXED(name, type, size, uint8_t)
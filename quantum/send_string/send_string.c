@@ -340,3 +340,321 @@ void send_string_with_delay_P(const char *string, uint8_t interval) {
     }
 }
 #endif
+
+#ifdef SEND_STRING_ASYNC_ENABLE
+#    include "action_util.h"
+#    include "eeprom.h"
+#    include "ring_buffer.h"
+#    include "timer.h"
+
+#    ifndef SEND_STRING_ASYNC_QUEUE_SIZE
+#        define SEND_STRING_ASYNC_QUEUE_SIZE 4
+#    endif
+
+#    if defined(NKRO_ENABLE) && defined(SEND_STRING_NKRO_PACKING)
+#        include "host.h"
+#        include "keycode_config.h"
+#        ifndef SEND_STRING_NKRO_PACKING_SIZE
+#            define SEND_STRING_NKRO_PACKING_SIZE 6
+#        endif
+#        define SEND_STRING_BATCH_SIZE SEND_STRING_NKRO_PACKING_SIZE
+#    else
+#        define SEND_STRING_BATCH_SIZE 1
+#    endif
+
+typedef enum { SEND_STRING_SOURCE_RAM, SEND_STRING_SOURCE_PROGMEM, SEND_STRING_SOURCE_EEPROM } send_string_source_t;
+
+typedef struct {
+    const char                *cursor;
+    send_string_async_callback callback;
+    void                      *cb_arg;
+    uint8_t                    interval;
+    uint8_t                    source;
+} send_string_job_t;
+
+RING_BUFFER_DEFINE(send_string_queue, send_string_job_t, SEND_STRING_ASYNC_QUEUE_SIZE);
+
+// A batch expands to at most: two modifier releases, two modifier presses, every key down,
+// every key up, two modifier releases, space, space
+#    define SEND_STRING_ASYNC_MAX_STEPS (8 + 2 * SEND_STRING_BATCH_SIZE)
+
+// Applied together with the following step, so that both reach the host in the same report
+#    define SEND_STRING_STEP_CHAINED 0x01
+#    define SEND_STRING_STEP_PRESSED 0x02
+
+typedef struct {
+    uint8_t keycode;
+    uint8_t flags;
+} send_string_step_t;
+
+static send_string_queue_t send_string_pending;
+static send_string_job_t   send_string_job;
+static bool                send_string_job_active = false;
+static send_string_step_t  send_string_steps[SEND_STRING_ASYNC_MAX_STEPS];
+static uint8_t             send_string_step_count = 0;
+static uint8_t             send_string_step_index = 0;
+static uint32_t            send_string_wait_start = 0;
+static uint32_t            send_string_wait_time  = 0;
+static bool                send_string_held_shift = false;
+static bool                send_string_held_altgr = false;
+
+/* Holds off the next step for `ms` milliseconds, counted from now. */
+static void send_string_wait(uint32_t ms) {
+    send_string_wait_start = timer_read32();
+    send_string_wait_time  = ms;
+}
+
+static bool send_string_waiting(void) {
+    return timer_elapsed32(send_string_wait_start) < send_string_wait_time;
+}
+
+/* Reads the next character of the job, leaving the cursor on the terminator once it is reached. */
+static char send_string_job_read(send_string_job_t *job) {
+    char c;
+    switch (job->source) {
+        case SEND_STRING_SOURCE_PROGMEM:
+            c = pgm_read_byte(job->cursor);
+            break;
+        case SEND_STRING_SOURCE_EEPROM:
+            c = eeprom_read_byte((const uint8_t *)job->cursor);
+            break;
+        default:
+            c = *job->cursor;
+            break;
+    }
+    if (c) {
+        job->cursor++;
+    }
+    return c;
+}
+
+static void send_string_add_step(uint8_t keycode, uint8_t flags) {
+    send_string_steps[send_string_step_count++] = (send_string_step_t){.keycode = keycode, .flags = flags};
+}
+
+/* Adds the steps that take the engine held modifiers from their current state to the requested one. */
+static void send_string_set_mods(bool shift, bool altgr) {
+    if (send_string_held_altgr && !altgr) send_string_add_step(KC_RIGHT_ALT, 0);
+    if (send_string_held_shift && !shift) send_string_add_step(KC_LEFT_SHIFT, 0);
+    if (shift && !send_string_held_shift) send_string_add_step(KC_LEFT_SHIFT, SEND_STRING_STEP_PRESSED);
+    if (altgr && !send_string_held_altgr) send_string_add_step(KC_RIGHT_ALT, SEND_STRING_STEP_PRESSED);
+    send_string_held_shift = shift;
+    send_string_held_altgr = altgr;
+}
+
+static bool send_string_is_plain_char(char ascii_code) {
+#    if defined(AUDIO_ENABLE) && defined(SENDSTRING_BELL)
+    if (ascii_code == '\a') {
+        return false;
+    }
+#    endif
+    return ascii_code && ascii_code != SS_QMK_PREFIX;
+}
+
+static bool send_string_can_pack(void) {
+#    if defined(NKRO_ENABLE) && defined(SEND_STRING_NKRO_PACKING)
+    return keyboard_protocol && keymap_config.nkro;
+#    else
+    return false;
+#    endif
+}
+
+/* Expands the next character or SS_* sequence of the job into steps. Returns false at the end of the string. */
+static bool send_string_job_decode(send_string_job_t *job) {
+    send_string_step_count = 0;
+    send_string_step_index = 0;
+
+    send_string_job_t ahead      = *job;
+    char              ascii_code = send_string_job_read(&ahead);
+    if (!send_string_is_plain_char(ascii_code) && (send_string_held_shift || send_string_held_altgr)) {
+        // Modifiers held across packed batches are released before anything else is sent
+        send_string_set_mods(false, false);
+        return true;
+    }
+    *job = ahead;
+    if (!ascii_code) {
+        return false;
+    }
+
+    if (ascii_code == SS_QMK_PREFIX) {
+        ascii_code      = send_string_job_read(job);
+        uint8_t keycode = 0;
+
+        switch (ascii_code) {
+            case SS_TAP_CODE:
+            case SS_DOWN_CODE:
+            case SS_UP_CODE:
+                keycode = send_string_job_read(job);
+                if (!keycode) {
+                    return false;
+                }
+                if (ascii_code != SS_UP_CODE) {
+                    send_string_add_step(keycode, SEND_STRING_STEP_PRESSED);
+                }
+                if (ascii_code != SS_DOWN_CODE) {
+                    send_string_add_step(keycode, 0);
+                }
+                break;
+            case SS_DELAY_CODE: {
+                uint32_t ms = 0;
+                while (isdigit(keycode = send_string_job_read(job))) {
+                    ms = ms * 10 + (keycode - '0');
+                }
+                send_string_wait(ms + job->interval);
+                break;
+            }
+            case 0:
+                return false;
+        }
+        return true;
+    }
+
+#    if defined(AUDIO_ENABLE) && defined(SENDSTRING_BELL)
+    if (ascii_code == '\a') { // BEL
+        PLAY_SONG(bell_song);
+        return true;
+    }
+#    endif
+
+    uint8_t keycode    = pgm_read_byte(&ascii_to_keycode_lut[(uint8_t)ascii_code]);
+    bool    is_shifted = PGM_LOADBIT(ascii_to_shift_lut, (uint8_t)ascii_code);
+    bool    is_altgred = PGM_LOADBIT(ascii_to_altgr_lut, (uint8_t)ascii_code);
+    bool    is_dead    = PGM_LOADBIT(ascii_to_dead_lut, (uint8_t)ascii_code);
+
+    uint8_t batch[SEND_STRING_BATCH_SIZE] = {keycode};
+    uint8_t batch_size                    = 1;
+    bool    pack                          = send_string_can_pack() && !is_dead && keycode != KC_NO;
+
+    // The host reads a packed NKRO report in usage order, so a batch only grows while the keycodes
+    // strictly increase; this also sends repeated letters sequentially
+    while (pack && batch_size < SEND_STRING_BATCH_SIZE) {
+        ahead           = *job;
+        char    next    = send_string_job_read(&ahead);
+        uint8_t next_kc = pgm_read_byte(&ascii_to_keycode_lut[(uint8_t)next]);
+        if (!send_string_is_plain_char(next) || next_kc <= batch[batch_size - 1] || PGM_LOADBIT(ascii_to_shift_lut, (uint8_t)next) != is_shifted || PGM_LOADBIT(ascii_to_altgr_lut, (uint8_t)next) != is_altgred || PGM_LOADBIT(ascii_to_dead_lut, (uint8_t)next)) {
+            break;
+        }
+        batch[batch_size++] = next_kc;
+        *job                = ahead;
+    }
+
+    send_string_set_mods(is_shifted, is_altgred);
+    for (uint8_t i = 0; i < batch_size; i++) {
+        send_string_add_step(batch[i], SEND_STRING_STEP_PRESSED | (i + 1 < batch_size ? SEND_STRING_STEP_CHAINED : 0));
+    }
+    for (uint8_t i = 0; i < batch_size; i++) {
+        send_string_add_step(batch[i], i + 1 < batch_size ? SEND_STRING_STEP_CHAINED : 0);
+    }
+    // When packing, modifiers stay held for the next batch if it needs them too
+    if (!pack) {
+        send_string_set_mods(false, false);
+    }
+    if (is_dead) {
+        send_string_add_step(KC_SPACE, SEND_STRING_STEP_PRESSED);
+        send_string_add_step(KC_SPACE, 0);
+    }
+    return true;
+}
+
+static bool send_string_enqueue(const char *cursor, uint8_t source, uint8_t interval, send_string_async_callback callback, void *cb_arg) {
+    send_string_job_t job = {.cursor = cursor, .callback = callback, .cb_arg = cb_arg, .interval = interval, .source = source};
+    return send_string_queue_push(&send_string_pending, job);
+}
+
+bool send_string_async(const char *string, uint8_t interval, send_string_async_callback callback, void *cb_arg) {
+    return send_string_enqueue(string, SEND_STRING_SOURCE_RAM, interval, callback, cb_arg);
+}
+
+bool send_string_async_P(const char *string, uint8_t interval, send_string_async_callback callback, void *cb_arg) {
+    return send_string_enqueue(string, SEND_STRING_SOURCE_PROGMEM, interval, callback, cb_arg);
+}
+
+bool send_string_async_eeprom(const void *address, uint8_t interval, send_string_async_callback callback, void *cb_arg) {
+    return send_string_enqueue((const char *)address, SEND_STRING_SOURCE_EEPROM, interval, callback, cb_arg);
+}
+
+bool send_string_async_busy(void) {
+    return send_string_job_active || !send_string_queue_empty(&send_string_pending);
+}
+
+static void send_string_job_finish(bool completed) {
+    send_string_job_active = false;
+    send_string_step_count = 0;
+    send_string_step_index = 0;
+    if (send_string_job.callback) {
+        send_string_job.callback(completed, send_string_job.cb_arg);
+    }
+}
+
+void send_string_async_cancel(void) {
+    if (send_string_job_active) {
+        // Release whatever the interrupted character still has held
+        for (; send_string_step_index < send_string_step_count; send_string_step_index++) {
+            if (!(send_string_steps[send_string_step_index].flags & SEND_STRING_STEP_PRESSED)) {
+                unregister_code(send_string_steps[send_string_step_index].keycode);
+            }
+        }
+        if (send_string_held_altgr) unregister_code(KC_RIGHT_ALT);
+        if (send_string_held_shift) unregister_code(KC_LEFT_SHIFT);
+        send_string_held_shift = false;
+        send_string_held_altgr = false;
+        send_string_job_finish(false);
+    }
+    while (send_string_queue_pop(&send_string_pending, &send_string_job)) {
+        if (send_string_job.callback) {
+            send_string_job.callback(false, send_string_job.cb_arg);
+        }
+    }
+}
+
+static bool send_string_job_start(void) {
+    if (!send_string_queue_pop(&send_string_pending, &send_string_job)) {
+        return false;
+    }
+    send_string_job_active = true;
+    return true;
+}
+
+void send_string_task(void) {
+    if (!send_string_job_active) {
+        if (!send_string_job_start()) {
+            return;
+        }
+        send_string_wait(0);
+    }
+    if (send_string_waiting()) {
+        return;
+    }
+
+    // Find the next key event, at most one per call so that every state reaches the host as its own report
+    while (send_string_step_index >= send_string_step_count) {
+        if (!send_string_job_active && !send_string_job_start()) {
+            return;
+        }
+        if (!send_string_job_decode(&send_string_job)) {
+            send_string_job_finish(true);
+            continue;
+        }
+        if (send_string_waiting()) {
+            // SS_DELAY
+            return;
+        }
+    }
+
+    send_string_step_t step = send_string_steps[send_string_step_index++];
+    while (step.flags & SEND_STRING_STEP_CHAINED) {
+        if (step.flags & SEND_STRING_STEP_PRESSED) {
+            add_key(step.keycode);
+        } else {
+            del_key(step.keycode);
+        }
+        step = send_string_steps[send_string_step_index++];
+    }
+    if (step.flags & SEND_STRING_STEP_PRESSED) {
+        register_code(step.keycode);
+    } else {
+        unregister_code(step.keycode);
+    }
+    send_string_wait(send_string_job.interval);
+}
+#endif
@@ -161,4 +161,69 @@ void send_string_with_delay_P(const char *string, uint8_t interval);
  */
 #define SEND_STRING_DELAY(string, interval) send_string_with_delay_P(PSTR(string), interval)
 
+#if defined(SEND_STRING_ASYNC_ENABLE) || defined(__DOXYGEN__)
+#    include <stdbool.h>
+#    include <stddef.h>
+
+/**
+ * \brief Called once a queued string has been typed out, or has been dropped by `send_string_async_cancel()`.
+ *
+ * \param completed `true` if the whole string was sent, `false` if it was cancelled.
+ * \param cb_arg The argument given when the string was queued.
+ */
+typedef void (*send_string_async_callback)(bool completed, void *cb_arg);
+
+/**
+ * \brief Queue a string of ASCII characters to be typed out in the background.
+ *
+ * Accepts the same characters and `SS_*` sequences as `send_string()`. The string is sent one key press or release
+ * per call to `send_string_task()`, with `interval` milliseconds between each, and `SS_DELAY` pauses the string
+ * without blocking the rest of the firmware. The string is not copied, so it must stay valid until it has been sent.
+ *
+ * \param string The string to type out.
+ * \param interval The amount of time, in milliseconds, to wait between each key press and release.
+ * \param callback Invoked when the string has been sent or cancelled. May be `NULL`.
+ * \param cb_arg Passed to `callback`.
+ *
+ * \return `true` if the string was queued, `false` if the queue is full.
+ */
+bool send_string_async(const char *string, uint8_t interval, send_string_async_callback callback, void *cb_arg);
+
+/**
+ * \brief Queue a PROGMEM string of ASCII characters to be typed out in the background.
+ *
+ * \see send_string_async()
+ */
+bool send_string_async_P(const char *string, uint8_t interval, send_string_async_callback callback, void *cb_arg);
+
+/**
+ * \brief Queue a null terminated string stored in EEPROM to be typed out in the background.
+ *
+ * \see send_string_async()
+ */
+bool send_string_async_eeprom(const void *address, uint8_t interval, send_string_async_callback callback, void *cb_arg);
+
+/**
+ * \brief Whether a string is currently being sent or is waiting in the queue.
+ */
+bool send_string_async_busy(void);
+
+/**
+ * \brief Drop the string being sent and everything queued behind it.
+ *
+ * Keys pressed as part of the character being typed are released first. Keys held with `SS_DOWN` are left held.
+ */
+void send_string_async_cancel(void);
+
+/**
+ * \brief Sends the next step of the queued strings. Called from the main loop, should not be invoked by keyboard/user code.
+ */
+void send_string_task(void);
+
+/**
+ * \brief Shortcut macro for send_string_async_P(PSTR(string), 0, NULL, NULL).
+ */
+#    define SEND_STRING_ASYNC(string) send_string_async_P(PSTR(string), 0, NULL, NULL)
+#endif
+
 /** \} */
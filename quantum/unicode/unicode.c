@@ -24,6 +24,7 @@
 #include "keycode.h"
 #include "wait.h"
 #include "send_string.h"
+#include "ring_buffer.h"
 #include "utf8.h"
 #include "debug.h"
 #include "quantum.h"
@@ -136,7 +137,7 @@ static void unicode_play_song(uint8_t mode) {
 #endif
 
 void unicode_input_mode_init(void) {
-    unicode_config.raw = eeprom_read_byte(EECONFIG_UNICODEMODE);
+    unicode_config.raw = eeconfig_read_byte(EECONFIG_UNICODEMODE);
 #if UNICODE_SELECTED_MODES != -1
 #    if UNICODE_CYCLE_PERSIST
     // Find input_mode in selected modes
@@ -165,7 +166,7 @@ uint8_t get_unicode_input_mode(void) {
 }
 
 static void persist_unicode_input_mode(void) {
-    eeprom_update_byte(EECONFIG_UNICODEMODE, unicode_config.input_mode);
+    eeconfig_update_byte(EECONFIG_UNICODEMODE, unicode_config.input_mode);
 }
 
 void set_unicode_input_mode(uint8_t mode) {
@@ -390,3 +391,270 @@ void send_unicode_string(const char *str) {
         }
     }
 }
+
+#ifdef UNICODEMAP_ASYNC
+#    ifndef SEND_STRING_ASYNC_ENABLE
+#        error "UNICODEMAP_ASYNC requires SEND_STRING_ASYNC_ENABLE = yes"
+#    endif
+
+#    ifndef UNICODE_ASYNC_QUEUE_SIZE
+#        define UNICODE_ASYNC_QUEUE_SIZE 2
+#    endif
+
+#    ifndef UNICODE_ASYNC_INTERVAL
+#        define UNICODE_ASYNC_INTERVAL TAP_CODE_DELAY
+#    endif
+
+// Longest rendered sequence is Linux with Caps Lock on: two Caps Lock taps, a fully modded lead key,
+// a delay, six digits and a space, which fits comfortably
+#    define UNICODE_SEQUENCE_SIZE 64
+
+typedef struct {
+    char    buffer[UNICODE_SEQUENCE_SIZE];
+    uint8_t length;
+} unicode_sequence_t;
+
+// Code points waiting to be typed, the one being typed is not counted
+RING_BUFFER_DEFINE(unicode_async_queue, uint32_t, UNICODE_ASYNC_QUEUE_SIZE);
+
+static unicode_async_queue_t unicode_async_queue;
+static unicode_sequence_t    unicode_async_sequence;
+static bool                  unicode_async_typing        = false;
+static uint8_t               unicode_async_saved_mods    = 0;
+static uint8_t               unicode_async_restored_mods = 0;
+
+static void unicode_sequence_put(unicode_sequence_t *sequence, char c) {
+    // An overlong sequence is dropped as a whole in register_unicode_async()
+    if (sequence->length < sizeof(sequence->buffer)) {
+        sequence->buffer[sequence->length] = c;
+    }
+    sequence->length++;
+}
+
+static void unicode_sequence_code(unicode_sequence_t *sequence, uint8_t code, uint8_t keycode) {
+    unicode_sequence_put(sequence, SS_QMK_PREFIX);
+    unicode_sequence_put(sequence, code);
+    unicode_sequence_put(sequence, keycode);
+}
+
+/* Taps a keycode with modifiers, e.g. LCTL(LSFT(KC_U)), as separate modifier presses around the key. */
+static void unicode_sequence_tap16(unicode_sequence_t *sequence, uint16_t keycode) {
+    uint8_t mods     = QK_MODS_GET_MODS(keycode);
+    uint8_t mod_base = (mods & 0x10) ? KC_RIGHT_CTRL : KC_LEFT_CTRL;
+
+    for (uint8_t i = 0; i < 4; i++) {
+        if (mods & (1 << i)) {
+            unicode_sequence_code(sequence, SS_DOWN_CODE, mod_base + i);
+        }
+    }
+    unicode_sequence_code(sequence, SS_TAP_CODE, QK_MODS_GET_BASIC_KEYCODE(keycode));
+    for (int8_t i = 3; i >= 0; i--) {
+        if (mods & (1 << i)) {
+            unicode_sequence_code(sequence, SS_UP_CODE, mod_base + i);
+        }
+    }
+}
+
+static void unicode_sequence_delay(unicode_sequence_t *sequence, uint16_t ms) {
+    char digits[5];
+    int8_t count = 0;
+    do {
+        digits[count++] = '0' + ms % 10;
+        ms /= 10;
+    } while (ms);
+
+    unicode_sequence_put(sequence, SS_QMK_PREFIX);
+    unicode_sequence_put(sequence, SS_DELAY_CODE);
+    while (count) {
+        unicode_sequence_put(sequence, digits[--count]);
+    }
+    unicode_sequence_put(sequence, '|');
+}
+
+static void unicode_sequence_nibble(unicode_sequence_t *sequence, uint8_t digit) {
+    if (unicode_config.input_mode == UNICODE_MODE_WINDOWS) {
+        unicode_sequence_code(sequence, SS_TAP_CODE, digit < 10 ? KC_KP_1 + (10 + digit - 1) % 10 : KC_A + (digit - 10));
+    } else {
+        // Same keys as send_nibble(), but as raw keycodes so the send_string lookup tables do not apply
+        unicode_sequence_code(sequence, SS_TAP_CODE, digit < 10 ? KC_1 + (10 + digit - 1) % 10 : KC_A + (digit - 10));
+    }
+}
+
+/* Same digit rules as register_hex32(). */
+static void unicode_sequence_hex32(unicode_sequence_t *sequence, uint32_t hex) {
+    bool first_digit        = true;
+    bool needs_leading_zero = (unicode_config.input_mode == UNICODE_MODE_WINCOMPOSE);
+    for (int i = 7; i >= 0; i--) {
+        uint8_t digit = ((hex >> (i * 4)) & 0xF);
+        if (first_digit && needs_leading_zero && digit > 9) {
+            unicode_sequence_nibble(sequence, 0);
+        }
+        if (digit != 0 || !first_digit || i < 4) {
+            unicode_sequence_nibble(sequence, digit);
+            first_digit = false;
+        }
+    }
+}
+
+/* Renders the whole input sequence of the current mode, mirroring unicode_input_start(), register_unicode() and unicode_input_finish(). */
+static void unicode_sequence_render(unicode_sequence_t *sequence, uint32_t code_point, led_t led_state) {
+    sequence->length = 0;
+
+    switch (unicode_config.input_mode) {
+        case UNICODE_MODE_MACOS:
+            unicode_sequence_code(sequence, SS_DOWN_CODE, UNICODE_KEY_MAC);
+            break;
+        case UNICODE_MODE_LINUX:
+            if (led_state.caps_lock) {
+                unicode_sequence_code(sequence, SS_TAP_CODE, KC_CAPS_LOCK);
+            }
+            unicode_sequence_tap16(sequence, UNICODE_KEY_LNX);
+            break;
+        case UNICODE_MODE_WINDOWS:
+            if (!led_state.num_lock) {
+                unicode_sequence_code(sequence, SS_TAP_CODE, KC_NUM_LOCK);
+            }
+            unicode_sequence_code(sequence, SS_DOWN_CODE, KC_LEFT_ALT);
+            unicode_sequence_delay(sequence, UNICODE_TYPE_DELAY);
+            unicode_sequence_code(sequence, SS_TAP_CODE, KC_KP_PLUS);
+            break;
+        case UNICODE_MODE_WINCOMPOSE:
+            unicode_sequence_code(sequence, SS_TAP_CODE, UNICODE_KEY_WINC);
+            unicode_sequence_code(sequence, SS_TAP_CODE, KC_U);
+            break;
+        case UNICODE_MODE_EMACS:
+            unicode_sequence_tap16(sequence, LCTL(KC_X));
+            unicode_sequence_code(sequence, SS_TAP_CODE, KC_8);
+            unicode_sequence_code(sequence, SS_TAP_CODE, KC_ENTER);
+            break;
+    }
+    unicode_sequence_delay(sequence, UNICODE_TYPE_DELAY);
+
+    if (code_point > 0xFFFF && unicode_config.input_mode == UNICODE_MODE_MACOS) {
+        code_point -= 0x10000;
+        unicode_sequence_hex32(sequence, ((code_point & 0xFFC00) >> 10) + 0xD800);
+        unicode_sequence_hex32(sequence, (code_point & 0x3FF) + 0xDC00);
+    } else {
+        unicode_sequence_hex32(sequence, code_point);
+    }
+
+    switch (unicode_config.input_mode) {
+        case UNICODE_MODE_MACOS:
+            unicode_sequence_code(sequence, SS_UP_CODE, UNICODE_KEY_MAC);
+            break;
+        case UNICODE_MODE_LINUX:
+            unicode_sequence_code(sequence, SS_TAP_CODE, KC_SPACE);
+            if (led_state.caps_lock) {
+                unicode_sequence_code(sequence, SS_TAP_CODE, KC_CAPS_LOCK);
+            }
+            break;
+        case UNICODE_MODE_WINDOWS:
+            unicode_sequence_code(sequence, SS_UP_CODE, KC_LEFT_ALT);
+            if (!led_state.num_lock) {
+                unicode_sequence_code(sequence, SS_TAP_CODE, KC_NUM_LOCK);
+            }
+            break;
+        case UNICODE_MODE_WINCOMPOSE:
+        case UNICODE_MODE_EMACS:
+            unicode_sequence_code(sequence, SS_TAP_CODE, KC_ENTER);
+            break;
+    }
+}
+
+static bool unicode_async_pending(void) {
+    return unicode_async_typing || !unicode_async_queue_empty(&unicode_async_queue);
+}
+
+static void unicode_async_restore_mods(void) {
+    // Reregister previously set mods, keeping any pressed in the meantime
+    if (unicode_async_saved_mods) {
+        add_mods(unicode_async_saved_mods);
+        unicode_async_saved_mods = 0;
+        send_keyboard_report();
+    }
+}
+
+static void unicode_async_finished(bool completed, void *cb_arg) {
+    unicode_async_typing = false;
+    if (!completed) {
+        // Cancelled along with the rest of the send_string queue
+        unicode_async_queue_clear(&unicode_async_queue);
+    }
+    if (!unicode_async_pending()) {
+        unicode_async_restore_mods();
+    }
+}
+
+void unicode_task(void) {
+    uint32_t code_point;
+    if (unicode_async_typing || !unicode_async_queue_peek(&unicode_async_queue, &code_point)) {
+        return;
+    }
+
+    unicode_sequence_t *sequence = &unicode_async_sequence;
+    unicode_sequence_render(sequence, code_point, host_keyboard_led_state());
+    if (sequence->length >= sizeof(sequence->buffer)) {
+        dprintf("Unicode sequence for U+%04lX too long\n", (unsigned long)code_point);
+        unicode_async_queue_pop(&unicode_async_queue, &code_point);
+        if (!unicode_async_pending()) {
+            unicode_async_restore_mods();
+        }
+        return;
+    }
+    sequence->buffer[sequence->length] = '\0';
+
+    // The send_string queue is shared with other callers, try again on the next pass if it is full
+    if (send_string_async(sequence->buffer, UNICODE_ASYNC_INTERVAL, unicode_async_finished, NULL)) {
+        unicode_async_queue_pop(&unicode_async_queue, &code_point);
+        unicode_async_typing = true;
+    }
+}
+
+void unicode_async_action_start(void) {
+    if (!unicode_async_pending() || !unicode_async_saved_mods) {
+        return;
+    }
+    // Let the action see the held back mods, so whatever it releases is released for real
+    unicode_async_restored_mods = unicode_async_saved_mods & ~get_mods();
+    add_mods(unicode_async_restored_mods);
+    set_unicode_held_back_mods(unicode_async_restored_mods);
+}
+
+void unicode_async_action_end(void) {
+    if (!unicode_async_restored_mods) {
+        return;
+    }
+    uint8_t mods = get_mods();
+    unicode_async_saved_mods &= ~(unicode_async_restored_mods & ~mods);
+    del_mods(unicode_async_restored_mods & mods);
+    unicode_async_restored_mods = 0;
+    set_unicode_held_back_mods(0);
+}
+
+bool register_unicode_async(uint32_t code_point) {
+    if (code_point > 0x10FFFF || (code_point > 0xFFFF && unicode_config.input_mode == UNICODE_MODE_WINDOWS)) {
+        // Code point out of range, do nothing
+        return false;
+    }
+
+    bool was_pending = unicode_async_pending();
+    if (!unicode_async_queue_push(&unicode_async_queue, code_point)) {
+        dprintf("Unicode queue full, dropping U+%04lX\n", (unsigned long)code_point);
+        return false;
+    }
+
+    // Typed with no modifiers held, like unicode_input_start() does, until the last queued sequence is done.
+    // While one is in flight the modifiers belong to it and are left alone.
+    if (!was_pending) {
+        unicode_async_saved_mods = get_mods();
+        clear_mods();
+        clear_weak_mods();
+        if (unicode_async_saved_mods) {
+            send_keyboard_report();
+        }
+    }
+
+    unicode_task();
+    return true;
+}
+#endif
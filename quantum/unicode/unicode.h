@@ -17,6 +17,7 @@
 #pragma once
 
 #include <stdint.h>
+#include <stdbool.h>
 #include "unicode_keycodes.h"
 
 /**
@@ -131,4 +132,35 @@ void register_unicode(uint32_t code_point);
  */
 void send_unicode_string(const char *str);
 
+#if defined(UNICODEMAP_ASYNC) || defined(__DOXYGEN__)
+/**
+ * \brief Queue a single Unicode character to be typed out in the background.
+ *
+ * The whole input sequence of the current mode is rendered and sent through `send_string_async()` by
+ * `unicode_task()`, so the keyboard keeps scanning while it is typed. Modifiers are released until the last queued
+ * character is done. Custom `unicode_input_start()` and `unicode_input_finish()` implementations are not used.
+ *
+ * \param code_point The code point of the character to send.
+ *
+ * \return `false` if the code point cannot be typed in the current mode, or the queue is full.
+ */
+bool register_unicode_async(uint32_t code_point);
+
+/**
+ * \brief Hand the next queued Unicode character to the send_string queue once the previous one is done.
+ */
+void unicode_task(void);
+
+/**
+ * \brief Give the modifiers held back for background Unicode input back to the action about to run, hidden from
+ * reports, so that releasing them is seen.
+ */
+void unicode_async_action_start(void);
+
+/**
+ * \brief Hold back the modifiers again after the action, forgetting the ones it released.
+ */
+void unicode_async_action_end(void);
+#endif
+
 /** \} */
@@ -39,5 +39,9 @@ uint32_t unicodemap_get_code_point(uint8_t index) {
 }
 
 void register_unicodemap(uint8_t index) {
+#ifdef UNICODEMAP_ASYNC
+    register_unicode_async(unicodemap_get_code_point(index));
+#else
     register_unicode(unicodemap_get_code_point(index));
+#endif
 }
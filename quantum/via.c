@@ -89,8 +89,14 @@ void via_eeprom_set_valid(bool valid) {
 // the caller also needs to check the valid state.
 __attribute__((weak)) void via_init_kb(void) {}
 
+static bool via_command(uint8_t *data, uint8_t length);
+
 // Called by QMK core to initialize dynamic keymaps etc.
 void via_init(void) {
+    // Keyboard level code can register handlers for other command IDs,
+    // the router answers the rest with id_unhandled.
+    raw_hid_register_handler(id_get_protocol_version, id_dynamic_keymap_set_encoder, via_command);
+
     // Let keyboard level test EEPROM valid state,
     // but not set it valid, it is done here.
     via_init_kb();
@@ -221,6 +227,7 @@ __attribute__((weak)) void via_custom_value_command_kb(uint8_t *data, uint8_t le
 //      id_qmk_rgb_matrix_channel   ->  via_qmk_rgb_matrix_command()
 //      id_qmk_led_matrix_channel   ->  via_qmk_led_matrix_command()
 //      id_qmk_audio_channel        ->  via_qmk_audio_command()
+//      id_qmk_bulk_channel         ->  via_qmk_bulk_command()
 //
 __attribute__((weak)) void via_custom_value_command(uint8_t *data, uint8_t length) {
     // data = [ command_id, channel_id, value_id, value_data ]
@@ -261,6 +268,13 @@ __attribute__((weak)) void via_custom_value_command(uint8_t *data, uint8_t lengt
     }
 #endif // AUDIO_ENABLE
 
+#if defined(VIA_BULK_TRANSFER_ENABLE)
+    if (*channel_id == id_qmk_bulk_channel) {
+        via_qmk_bulk_command(data, length);
+        return;
+    }
+#endif // VIA_BULK_TRANSFER_ENABLE
+
     (void)channel_id; // force use of variable
 
     // If we haven't returned before here, then let the keyboard level code
@@ -276,16 +290,12 @@ __attribute__((weak)) bool via_command_kb(uint8_t *data, uint8_t length) {
     return false;
 }
 
-void raw_hid_receive(uint8_t *data, uint8_t length) {
+static bool via_command(uint8_t *data, uint8_t length) {
     uint8_t *command_id   = &(data[0]);
     uint8_t *command_data = &(data[1]);
 
-    // If via_command_kb() returns true, the command was fully
-    // handled, including calling raw_hid_send()
-    if (via_command_kb(data, length)) {
-        return;
-    }
-
+    // via_command_kb() has already been given the command by the raw HID
+    // router, which also answers IDs outside this range with id_unhandled.
     switch (*command_id) {
         case id_get_protocol_version: {
             command_data[0] = VIA_PROTOCOL_VERSION >> 8;
@@ -458,7 +468,7 @@ void raw_hid_receive(uint8_t *data, uint8_t length) {
 
     // Return the same buffer, optionally with values changed
     // (i.e. returning state to the host, or the unhandled state).
-    raw_hid_send(data, length);
+    return true;
 }
 
 #if defined(BACKLIGHT_ENABLE)
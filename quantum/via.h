@@ -71,6 +71,26 @@
 #    define VIA_FIRMWARE_VERSION 0x00000000
 #endif
 
+#ifdef VIA_BULK_TRANSFER_ENABLE
+// Number of keymap buffer bytes covered by each CRC returned by
+// id_qmk_bulk_buffer_crc. Smaller blocks mean smaller diffs
+// but more CRC packets.
+#    ifndef VIA_BULK_BLOCK_SIZE
+#        define VIA_BULK_BLOCK_SIZE 32
+#    endif
+
+// RAM used to stage a streamed keymap write, which bounds the size of a
+// write session. Nothing reaches EEPROM before id_qmk_bulk_write_commit,
+// so larger keymaps are written as several sessions.
+#    ifndef VIA_BULK_WRITE_BUFFER_SIZE
+#        if defined(__AVR__)
+#            define VIA_BULK_WRITE_BUFFER_SIZE 128
+#        else
+#            define VIA_BULK_WRITE_BUFFER_SIZE 1024
+#        endif
+#    endif
+#endif
+
 enum via_command_id {
     id_get_protocol_version                 = 0x01, // always 0x01
     id_get_keyboard_value                   = 0x02,
@@ -111,6 +131,7 @@ enum via_channel_id {
     id_qmk_rgb_matrix_channel = 3,
     id_qmk_audio_channel      = 4,
     id_qmk_led_matrix_channel = 5,
+    id_qmk_bulk_channel       = 6,
 };
 
 enum via_qmk_backlight_value {
@@ -143,6 +164,41 @@ enum via_qmk_audio_value {
     id_qmk_audio_clicky_enable = 2,
 };
 
+// Bulk keymap transfer (VIA_BULK_TRANSFER_ENABLE), answered with id_unhandled
+// by firmware built without it:
+//
+// id_custom_get_value, id_qmk_bulk_channel, id_qmk_bulk_buffer_crc
+//   [ ..., block_hi, block_lo, count ] -> [ ..., block_hi, block_lo, count, block_size, crc8... ]
+//   CRC8 of up to 25 consecutive VIA_BULK_BLOCK_SIZE blocks of the keymap buffer,
+//   `count` is trimmed to the number of CRCs returned. The host reads back with
+//   id_dynamic_keymap_get_buffer only the blocks whose CRC differs from its copy.
+//
+// id_custom_set_value, id_qmk_bulk_channel, id_qmk_bulk_write_begin
+//   [ ..., offset_hi, offset_lo, size_hi, size_lo ] -> [ ..., status, payload_size ]
+//   `size` can be at most VIA_BULK_WRITE_BUFFER_SIZE.
+// id_custom_set_value, id_qmk_bulk_channel, id_qmk_bulk_write_data
+//   [ ..., sequence, payload... ] -> [ ..., sequence, status ]
+//   `sequence` starts at 0 and increments (wrapping) with every packet, each packet
+//   but the last carries exactly `payload_size` bytes. Packets can be sent without
+//   waiting for the previous reply, a gap in the sequence aborts the session.
+// id_custom_set_value, id_qmk_bulk_channel, id_qmk_bulk_write_commit
+//   [ ... ] -> [ ..., status ]
+//   Writes the staged data to EEPROM and ends the session.
+enum via_qmk_bulk_value {
+    id_qmk_bulk_buffer_crc   = 1,
+    id_qmk_bulk_write_begin  = 2,
+    id_qmk_bulk_write_data   = 3,
+    id_qmk_bulk_write_commit = 4,
+};
+
+enum via_bulk_status {
+    id_bulk_ok           = 0x00,
+    id_bulk_out_of_range = 0x01,
+    id_bulk_no_session   = 0x02,
+    id_bulk_bad_sequence = 0x03,
+    id_bulk_incomplete   = 0x04,
+};
+
 // Can be called in an overriding via_init_kb() to test if keyboard level code usage of
 // EEPROM is invalid and use/save defaults.
 bool via_eeprom_is_valid(void);
@@ -168,6 +224,10 @@ void via_set_device_indication(uint8_t value);
 // Called by QMK core to process VIA-specific keycodes.
 bool process_record_via(uint16_t keycode, keyrecord_t *record);
 
+// Given every received command before VIA handles it, returns true if it
+// was fully handled, including calling raw_hid_send().
+bool via_command_kb(uint8_t *data, uint8_t length);
+
 // These are made external so that keyboard level custom value handlers can use them.
 #if defined(BACKLIGHT_ENABLE)
 void via_qmk_backlight_command(uint8_t *data, uint8_t length);
@@ -202,4 +262,8 @@ void via_qmk_audio_command(uint8_t *data, uint8_t length);
 void via_qmk_audio_set_value(uint8_t *data);
 void via_qmk_audio_get_value(uint8_t *data);
 void via_qmk_audio_save(void);
-#endif
\ No newline at end of file
+#endif
+
+#if defined(VIA_BULK_TRANSFER_ENABLE)
+void via_qmk_bulk_command(uint8_t *data, uint8_t length);
+#endif
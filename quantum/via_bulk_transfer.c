@@ -0,0 +1,139 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "via.h"
+#include "dynamic_keymap.h"
+#include "crc.h"
+#include "util.h"
+
+_Static_assert(VIA_BULK_BLOCK_SIZE > 0 && VIA_BULK_BLOCK_SIZE <= 255, "VIA_BULK_BLOCK_SIZE must fit in one byte");
+
+// State of the streamed keymap write started by id_qmk_bulk_write_begin
+static struct {
+    bool     active;
+    uint8_t  sequence;
+    uint16_t offset;
+    uint16_t size;
+    uint16_t received;
+} via_bulk_write;
+
+static uint8_t via_bulk_write_buffer[VIA_BULK_WRITE_BUFFER_SIZE];
+
+static void via_bulk_get_buffer_crc(uint8_t *data, uint8_t length) {
+    // data = [ value_id, block_hi, block_lo, count, block_size, crc... ]
+    uint16_t block       = (data[1] << 8) | data[2];
+    uint16_t buffer_size = dynamic_keymap_get_buffer_size();
+    uint16_t block_count = (buffer_size + VIA_BULK_BLOCK_SIZE - 1) / VIA_BULK_BLOCK_SIZE;
+    uint8_t  count       = MIN(data[3], length - 5);
+    uint8_t  contents[VIA_BULK_BLOCK_SIZE];
+
+    if (block >= block_count) {
+        count = 0;
+    } else if (count > block_count - block) {
+        count = block_count - block;
+    }
+
+    for (uint8_t i = 0; i < count; i++) {
+        uint16_t offset = (block + i) * VIA_BULK_BLOCK_SIZE;
+        uint16_t size   = MIN(VIA_BULK_BLOCK_SIZE, buffer_size - offset);
+        dynamic_keymap_get_buffer(offset, size, contents);
+        data[5 + i] = crc8(contents, size);
+    }
+    data[3] = count;
+    data[4] = VIA_BULK_BLOCK_SIZE;
+}
+
+static void via_bulk_write_begin(uint8_t *data, uint8_t length) {
+    // data = [ value_id, offset_hi, offset_lo, size_hi, size_lo, status, payload_size ]
+    uint16_t offset = (data[1] << 8) | data[2];
+    uint16_t size   = (data[3] << 8) | data[4];
+
+    via_bulk_write.active = false;
+    if (size == 0 || size > sizeof(via_bulk_write_buffer) || offset > dynamic_keymap_get_buffer_size() || size > dynamic_keymap_get_buffer_size() - offset) {
+        data[5] = id_bulk_out_of_range;
+        return;
+    }
+
+    via_bulk_write.active   = true;
+    via_bulk_write.sequence = 0;
+    via_bulk_write.offset   = offset;
+    via_bulk_write.size     = size;
+    via_bulk_write.received = 0;
+    data[5]                 = id_bulk_ok;
+    data[6]                 = length - 2;
+}
+
+static void via_bulk_write_data(uint8_t *data, uint8_t length) {
+    // data = [ value_id, sequence, payload... ], status returned in data[2]
+    uint8_t *payload = &data[2];
+    uint8_t  size    = MIN(length - 2, via_bulk_write.size - via_bulk_write.received);
+
+    if (!via_bulk_write.active) {
+        data[2] = id_bulk_no_session;
+        return;
+    }
+    if (data[1] != via_bulk_write.sequence || size == 0) {
+        // Dropped or repeated packet, what has been staged is no longer trustworthy
+        via_bulk_write.active = false;
+        data[2]               = id_bulk_bad_sequence;
+        return;
+    }
+
+    memcpy(&via_bulk_write_buffer[via_bulk_write.received], payload, size);
+    via_bulk_write.received += size;
+    via_bulk_write.sequence++;
+    data[2] = id_bulk_ok;
+}
+
+static void via_bulk_write_commit(uint8_t *data, uint8_t length) {
+    // data = [ value_id, status ]
+    if (!via_bulk_write.active) {
+        data[1] = id_bulk_no_session;
+        return;
+    }
+
+    via_bulk_write.active = false;
+    if (via_bulk_write.received != via_bulk_write.size) {
+        data[1] = id_bulk_incomplete;
+        return;
+    }
+    // The only EEPROM write of the session, an aborted one leaves the keymap untouched
+    dynamic_keymap_set_buffer(via_bulk_write.offset, via_bulk_write.size, via_bulk_write_buffer);
+    data[1] = id_bulk_ok;
+}
+
+void via_qmk_bulk_command(uint8_t *data, uint8_t length) {
+    // data = [ command_id, channel_id, value_id, value_data ]
+    uint8_t *command_id        = &(data[0]);
+    uint8_t *value_id_and_data = &(data[2]);
+    uint8_t  value_length      = length - 2;
+
+    switch (*command_id) {
+        case id_custom_set_value: {
+            switch (value_id_and_data[0]) {
+                case id_qmk_bulk_write_begin: {
+                    via_bulk_write_begin(value_id_and_data, value_length);
+                    return;
+                }
+                case id_qmk_bulk_write_data: {
+                    via_bulk_write_data(value_id_and_data, value_length);
+                    return;
+                }
+                case id_qmk_bulk_write_commit: {
+                    via_bulk_write_commit(value_id_and_data, value_length);
+                    return;
+                }
+            }
+            break;
+        }
+        case id_custom_get_value: {
+            if (value_id_and_data[0] == id_qmk_bulk_buffer_crc) {
+                via_bulk_get_buffer_crc(value_id_and_data, value_length);
+                return;
+            }
+            break;
+        }
+    }
+    *command_id = id_unhandled;
+}
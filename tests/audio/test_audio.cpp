@@ -115,4 +115,67 @@ TEST_F(AudioTest, BpmConversion) {
     }
 }
 
+TEST_F(AudioTest, CompactPitchDecoding) {
+    EXPECT_EQ(audio_compact_pitch_to_frequency(PITCH_REST), NOTE_REST);
+    EXPECT_EQ(audio_compact_pitch_to_frequency(PITCH_B8 + 1), NOTE_REST);
+    EXPECT_EQ(audio_compact_pitch_to_frequency(UINT8_MAX), NOTE_REST);
+
+    EXPECT_NEAR(audio_compact_pitch_to_frequency(PITCH_C0), NOTE_C0, 0.01);
+    EXPECT_NEAR(audio_compact_pitch_to_frequency(PITCH_A4), NOTE_A4, 0.01);
+    EXPECT_NEAR(audio_compact_pitch_to_frequency(PITCH_B8), NOTE_B8, 0.01);
+    EXPECT_EQ(audio_compact_pitch_to_frequency(PITCH_BF3), audio_compact_pitch_to_frequency(PITCH_AS3));
+
+    // Every step across all octaves is one equal tempered semitone
+    for (uint8_t pitch = PITCH_C0 + 1; pitch <= PITCH_B8; pitch++) {
+        SCOPED_TRACE("pitch " + testing::PrintToString(pitch));
+        float ratio = audio_compact_pitch_to_frequency(pitch) / audio_compact_pitch_to_frequency(pitch - 1);
+        ASSERT_NEAR(ratio, std::pow(2.0f, 1.0f / 12), 0.0001);
+    }
+}
+
+TEST_F(AudioTest, CompactSongLayout) {
+    const uint8_t song[] = COMPACT_SONG(COMPACT_NOTE(_A4, 16), COMPACT_NOTE(_REST, 8), COMPACT_NOTE(_EF5, 255));
+
+    ASSERT_EQ(COMPACT_NOTE_COUNT(song), 3);
+    EXPECT_EQ(song[0], PITCH_A4);
+    EXPECT_EQ(song[1], 16);
+    EXPECT_EQ(song[2], PITCH_REST);
+    EXPECT_EQ(song[3], 8);
+    EXPECT_EQ(song[4], PITCH_DS5);
+    EXPECT_EQ(song[5], 255);
+}
+
+TEST_F(AudioTest, CompactSongStartsWithItsFirstNote) {
+    static const uint8_t song[] PROGMEM = COMPACT_SONG(COMPACT_NOTE(_A4, 16), COMPACT_NOTE(_C5, 16));
+
+    audio_on();
+    PLAY_COMPACT_SONG(song);
+    EXPECT_TRUE(audio_is_playing_melody());
+    EXPECT_NEAR(audio_get_frequency(0), NOTE_A4, 0.01);
+
+    audio_stop_all();
+    EXPECT_FALSE(audio_is_playing_melody());
+    audio_off();
+}
+
+TEST_F(AudioTest, CompactSongPlaysLongestDuration) {
+    TestDriver           driver;
+    static const uint8_t song[] PROGMEM = COMPACT_SONG(COMPACT_NOTE(_A4, 255), COMPACT_NOTE(_C5, 16));
+    uint16_t             duration_ms    = audio_duration_to_ms(255);
+
+    audio_on();
+    PLAY_COMPACT_SONG(song);
+
+    idle_for(duration_ms - 1);
+    audio_update_state();
+    EXPECT_NEAR(audio_get_frequency(0), NOTE_A4, 0.01);
+
+    idle_for(1);
+    audio_update_state();
+    EXPECT_NEAR(audio_get_frequency(0), NOTE_C5, 0.01);
+
+    audio_stop_all();
+    audio_off();
+}
+
 } // namespace
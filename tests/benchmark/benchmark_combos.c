@@ -0,0 +1,16 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "quantum.h"
+
+enum combos { jk_escape, df_tab };
+
+uint16_t const jk_combo[] = {KC_J, KC_K, COMBO_END};
+uint16_t const df_combo[] = {LCTL_T(KC_D), LSFT_T(KC_F), COMBO_END};
+
+// clang-format off
+combo_t key_combos[] = {
+    [jk_escape] = COMBO(jk_combo, KC_ESCAPE),
+    [df_tab]    = COMBO(df_combo, KC_TAB)
+};
+// clang-format on
@@ -0,0 +1,236 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "benchmark_corpus.hpp"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+extern "C" {
+#include "quantum.h"
+}
+
+// clang-format off
+const std::vector<BenchmarkKey> benchmark_layout = {
+    {0, 0, KC_Q, KC_Q, 'q'}, {1, 0, KC_W, KC_W, 'w'}, {2, 0, KC_E, KC_E, 'e'}, {3, 0, KC_R, KC_R, 'r'}, {4, 0, KC_T, KC_T, 't'},
+    {5, 0, KC_Y, KC_Y, 'y'}, {6, 0, KC_U, KC_U, 'u'}, {7, 0, KC_I, KC_I, 'i'}, {8, 0, KC_O, KC_O, 'o'}, {9, 0, KC_P, KC_P, 'p'},
+
+    {0, 1, LGUI_T(KC_A), KC_A, 'a'}, {1, 1, LALT_T(KC_S), KC_S, 's'}, {2, 1, LCTL_T(KC_D), KC_D, 'd'}, {3, 1, LSFT_T(KC_F), KC_F, 'f'}, {4, 1, KC_G, KC_G, 'g'},
+    {5, 1, KC_H, KC_H, 'h'}, {6, 1, KC_J, KC_J, 'j'}, {7, 1, KC_K, KC_K, 'k'}, {8, 1, KC_L, KC_L, 'l'}, {9, 1, KC_SCLN, KC_SCLN, ';'},
+
+    {0, 2, KC_Z, KC_Z, 'z'}, {1, 2, KC_X, KC_X, 'x'}, {2, 2, KC_C, KC_C, 'c'}, {3, 2, KC_V, KC_V, 'v'}, {4, 2, KC_B, KC_B, 'b'},
+    {5, 2, KC_N, KC_N, 'n'}, {6, 2, KC_M, KC_M, 'm'}, {7, 2, KC_COMM, KC_COMM, ','}, {8, 2, KC_DOT, KC_DOT, '.'}, {9, 2, KC_SLSH, KC_SLSH, '/'},
+
+    {0, 3, KC_SPC, KC_SPC, ' '}, {1, 3, KC_ENT, KC_ENT, '\n'}, {2, 3, KC_BSPC, KC_BSPC, '\b'}, {3, 3, KC_QUOT, KC_QUOT, '\''}, {4, 3, KC_MINS, KC_MINS, '-'},
+};
+
+static const char *const corpus_words[] = {
+    "the", "of", "and", "to", "in", "is", "that", "for", "it", "as", "was", "with", "be", "by", "on", "not", "he",
+    "this", "are", "or", "his", "from", "at", "which", "but", "have", "an", "had", "they", "you", "were", "their",
+    "one", "all", "we", "can", "her", "has", "there", "been", "if", "more", "when", "will", "would", "who", "so",
+    "keyboard", "layer", "matrix", "firmware", "report", "switch", "scan", "combo", "macro", "tapping", "hold",
+    "release", "press", "timer", "buffer", "event", "queue", "state", "driver", "process", "record", "key's",
+    "half-duplex", "low-latency", "microcontroller", "debounce", "interrupt", "register", "compile", "options",
+};
+
+/* Misspellings from the default autocorrect dictionary, typed every so often. */
+static const char *const corpus_typos[] = {
+    "fales", "becuase", "foward", "fitler", "aquire", "cheif", "choosen", "fasle", "thier", "ture",
+};
+// clang-format on
+
+namespace {
+
+struct TimedEvent {
+    uint64_t time;
+    uint32_t order;
+    uint8_t  col;
+    uint8_t  row;
+    bool     pressed;
+};
+
+class CorpusBuilder {
+   public:
+    explicit CorpusBuilder(uint32_t seed) : m_state(seed ? seed : 0x9E3779B9) {
+        for (auto &row : m_released_at) {
+            for (auto &time : row) {
+                time = 0;
+            }
+        }
+    }
+
+    uint32_t random(uint32_t bound) {
+        // xorshift32, good enough for timing jitter and word choice
+        m_state ^= m_state << 13;
+        m_state ^= m_state >> 17;
+        m_state ^= m_state << 5;
+        return m_state % bound;
+    }
+
+    size_t size() const {
+        return m_events.size();
+    }
+
+    /* Taps `key`, optionally rolling into the next key before this one is released. */
+    void tap(const BenchmarkKey &key, bool allow_roll) {
+        uint64_t press   = std::max(m_cursor, m_released_at[key.row][key.col] + 20);
+        uint64_t release = press + 40 + random(50);
+        add(press, key, true);
+        add(release, key, false);
+        m_cursor = (allow_roll && random(6) == 0) ? press + (release - press) / 2 : release + 30 + random(90);
+    }
+
+    /* Holds `modifier` past the tapping term and taps `key` underneath it. */
+    void hold_and_tap(const BenchmarkKey &modifier, const BenchmarkKey &key) {
+        uint64_t press = std::max(m_cursor, m_released_at[modifier.row][modifier.col] + 20);
+        add(press, modifier, true);
+        m_cursor = press + TAPPING_TERM + 60;
+        tap(key, false);
+        add(m_cursor, modifier, false);
+        m_cursor += 30 + random(90);
+    }
+
+    /* Presses `first` and `second` within a few milliseconds of each other. */
+    void chord(const BenchmarkKey &first, const BenchmarkKey &second) {
+        uint64_t press = std::max({m_cursor, m_released_at[first.row][first.col] + 20, m_released_at[second.row][second.col] + 20});
+        add(press, first, true);
+        add(press + 1 + random(5), second, true);
+        add(press + 60 + random(20), first, false);
+        add(press + 62 + random(20), second, false);
+        m_cursor = press + 150 + random(100);
+    }
+
+    std::vector<CorpusEvent> finish() {
+        std::sort(m_events.begin(), m_events.end(), [](const TimedEvent &a, const TimedEvent &b) { return a.time != b.time ? a.time < b.time : a.order < b.order; });
+
+        std::vector<CorpusEvent> events;
+        events.reserve(m_events.size());
+        uint64_t last = 0;
+        for (const auto &event : m_events) {
+            // Gaps between generated events are well below a second, so they always fit
+            events.push_back({static_cast<uint16_t>(event.time - last), event.col, event.row, event.pressed});
+            last = event.time;
+        }
+        return events;
+    }
+
+   private:
+    void add(uint64_t time, const BenchmarkKey &key, bool pressed) {
+        m_events.push_back({time, static_cast<uint32_t>(m_events.size()), key.col, key.row, pressed});
+        if (!pressed) {
+            m_released_at[key.row][key.col] = time;
+        }
+    }
+
+    uint32_t                m_state;
+    uint64_t                m_cursor = 100;
+    uint64_t                m_released_at[MATRIX_ROWS][MATRIX_COLS];
+    std::vector<TimedEvent> m_events;
+};
+
+const BenchmarkKey &key_for(char character) {
+    for (const auto &key : benchmark_layout) {
+        if (key.character == character) {
+            return key;
+        }
+    }
+    return benchmark_layout.back();
+}
+
+} // namespace
+
+Corpus Corpus::synthesize(size_t min_events, uint32_t seed) {
+    CorpusBuilder       builder(seed);
+    const BenchmarkKey &shift = key_for('f');
+    const BenchmarkKey &space = key_for(' ');
+    bool                sentence_start = true;
+    uint32_t            words          = 0;
+
+    while (builder.size() < min_events) {
+        const char *word = builder.random(20) == 0 ? corpus_typos[builder.random(sizeof(corpus_typos) / sizeof(corpus_typos[0]))] : corpus_words[builder.random(sizeof(corpus_words) / sizeof(corpus_words[0]))];
+
+        for (const char *c = word; *c; c++) {
+            const BenchmarkKey &key = key_for(*c);
+            if (sentence_start && c == word && &key != &shift) {
+                builder.hold_and_tap(shift, key);
+            } else {
+                builder.tap(key, c[1] != '\0' && c[1] != c[0]);
+            }
+        }
+        sentence_start = false;
+
+        if (++words % 12 == 0) {
+            builder.tap(key_for('.'), false);
+            sentence_start = true;
+        } else if (words % 7 == 0) {
+            builder.tap(key_for(','), false);
+        }
+        if (words % 25 == 0) {
+            builder.chord(key_for('j'), key_for('k'));
+        } else if (words % 61 == 0) {
+            builder.chord(key_for('d'), key_for('f'));
+        }
+        builder.tap(space, false);
+    }
+
+    Corpus corpus;
+    corpus.name   = "synthetic (seed " + std::to_string(seed) + ")";
+    corpus.events = builder.finish();
+    return corpus;
+}
+
+bool Corpus::load(const std::string &path, Corpus &corpus, std::string &error) {
+    std::ifstream file(path);
+    if (!file) {
+        error = "cannot open " + path;
+        return false;
+    }
+
+    bool        held[MATRIX_ROWS][MATRIX_COLS] = {};
+    std::string line;
+    size_t      line_number = 0;
+
+    corpus.name = path;
+    corpus.events.clear();
+
+    while (std::getline(file, line)) {
+        line_number++;
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+
+        std::istringstream fields(line);
+        unsigned           delay, col, row;
+        char               direction;
+        if (!(fields >> delay >> col >> row >> direction) || delay > UINT16_MAX || col >= MATRIX_COLS || row >= MATRIX_ROWS || (direction != 'd' && direction != 'u')) {
+            error = path + ":" + std::to_string(line_number) + ": malformed event '" + line + "'";
+            return false;
+        }
+
+        bool pressed = direction == 'd';
+        if (held[row][col] == pressed) {
+            error = path + ":" + std::to_string(line_number) + ": key (" + std::to_string(col) + "," + std::to_string(row) + ") is already " + (pressed ? "down" : "up");
+            return false;
+        }
+        held[row][col] = pressed;
+        corpus.events.push_back({static_cast<uint16_t>(delay), static_cast<uint8_t>(col), static_cast<uint8_t>(row), pressed});
+    }
+
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            if (held[row][col]) {
+                corpus.events.push_back({50, col, row, false});
+            }
+        }
+    }
+
+    return true;
+}
+
+uint64_t Corpus::duration_ms() const {
+    uint64_t duration = 0;
+    for (const auto &event : events) {
+        duration += event.delay_ms;
+    }
+    return duration;
+}
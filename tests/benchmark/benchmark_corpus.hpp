@@ -0,0 +1,58 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief A single matrix transition, applied after `delay_ms` of idle scanning.
+ */
+struct CorpusEvent {
+    uint16_t delay_ms;
+    uint8_t  col;
+    uint8_t  row;
+    bool     pressed;
+};
+
+/**
+ * @brief Matrix position of a benchmark key, with the keycode it carries in the full
+ * feature set and the plain keycode used when tap-hold is benchmarked away.
+ */
+struct BenchmarkKey {
+    uint8_t  col;
+    uint8_t  row;
+    uint16_t keycode;
+    uint16_t plain_keycode;
+    char     character;
+};
+
+extern const std::vector<BenchmarkKey> benchmark_layout;
+
+struct Corpus {
+    std::string              name;
+    std::vector<CorpusEvent> events;
+
+    /**
+     * @brief Generates a deterministic typing corpus of at least `min_events` matrix events
+     * on `benchmark_layout`: English-like words with rolled key presses, sentence
+     * capitals typed through a held home-row mod-tap, common misspellings that the
+     * default autocorrect dictionary fixes, and periodic two-key combos.
+     */
+    static Corpus synthesize(size_t min_events, uint32_t seed);
+
+    /**
+     * @brief Loads a recorded corpus, one event per line:
+     *
+     *   <delay_ms> <col> <row> <d|u>
+     *
+     * Blank lines and lines starting with `#` are ignored. Keys still held at the end of
+     * the recording are released so every run ends with an empty matrix.
+     */
+    static bool load(const std::string& path, Corpus& corpus, std::string& error);
+
+    uint64_t duration_ms() const;
+};
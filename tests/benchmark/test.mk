@@ -0,0 +1,12 @@
+# Copyright 2023 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+# --------------------------------------------------------------------------------
+# Throughput benchmark: runs a long typing corpus through the full keyboard_task()
+# stack with the common "heavy" input features enabled.
+# --------------------------------------------------------------------------------
+
+COMBO_ENABLE = yes
+AUTOCORRECT_ENABLE = yes
+
+INTROSPECTION_KEYMAP_C = benchmark_combos.c
@@ -0,0 +1,255 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include "benchmark_corpus.hpp"
+#include "test_common.hpp"
+
+extern "C" {
+void advance_time(uint32_t ms);
+}
+
+using clock_type = std::chrono::steady_clock;
+using std::chrono::nanoseconds;
+
+namespace {
+
+/* Host report counters, filled by a bare host driver so that no gmock bookkeeping is timed. */
+struct HostCounters {
+    uint32_t keyboard;
+    uint32_t nkro;
+    uint32_t mouse;
+    uint32_t extra;
+
+    uint32_t total() const {
+        return keyboard + nkro + mouse + extra;
+    }
+};
+
+HostCounters host_counters;
+uint32_t     records_processed;
+
+uint8_t benchmark_keyboard_leds(void) {
+    return 0;
+}
+
+void benchmark_send_keyboard(report_keyboard_t *report) {
+    host_counters.keyboard++;
+}
+
+void benchmark_send_nkro(report_nkro_t *report) {
+    host_counters.nkro++;
+}
+
+void benchmark_send_mouse(report_mouse_t *report) {
+    host_counters.mouse++;
+}
+
+void benchmark_send_extra(report_extra_t *report) {
+    host_counters.extra++;
+}
+
+host_driver_t benchmark_driver = {benchmark_keyboard_leds, benchmark_send_keyboard, benchmark_send_nkro, benchmark_send_mouse, benchmark_send_extra};
+
+/**
+ * Scan loops are split into three stages by what happened during them:
+ *  - idle:     no matrix change and no host report, i.e. the fixed per-scan cost
+ *  - event:    a matrix change was applied, covering debounce, action_exec and the process_record chain
+ *  - deferred: no matrix change but a host report was sent, e.g. a tapping term or combo term expiring
+ */
+struct StageTime {
+    uint64_t    scans;
+    nanoseconds time;
+
+    double average_ns() const {
+        return scans ? static_cast<double>(time.count()) / scans : 0.0;
+    }
+};
+
+struct BenchmarkResult {
+    std::string  variant;
+    uint64_t     events;
+    uint32_t     records;
+    HostCounters reports;
+    StageTime    idle;
+    StageTime    event;
+    StageTime    deferred;
+
+    nanoseconds total() const {
+        return idle.time + event.time + deferred.time;
+    }
+
+    double events_per_second() const {
+        return total().count() ? events * 1e9 / total().count() : 0.0;
+    }
+};
+
+size_t environment_or(const char *name, size_t fallback) {
+    const char *value = std::getenv(name);
+    return value ? std::strtoul(value, nullptr, 10) : fallback;
+}
+
+const Corpus &benchmark_corpus() {
+    static Corpus corpus = [] {
+        const char *path = std::getenv("QMK_BENCHMARK_CORPUS");
+        if (path) {
+            Corpus      loaded;
+            std::string error;
+            if (Corpus::load(path, loaded, error)) {
+                return loaded;
+            }
+            ADD_FAILURE() << error;
+        }
+        return Corpus::synthesize(environment_or("QMK_BENCHMARK_EVENTS", 20000), 0x51C0FFEE);
+    }();
+    return corpus;
+}
+
+void print_result(const BenchmarkResult &result, const BenchmarkResult *baseline) {
+    std::printf("[ BENCH    ] %-14s %9.0f events/s  %7u reports (kb %u, nkro %u, mouse %u, extra %u)  %7u records\n", result.variant.c_str(), result.events_per_second(), result.reports.total(), result.reports.keyboard, result.reports.nkro, result.reports.mouse, result.reports.extra, result.records);
+    std::printf("[ BENCH    ] %-14s idle %8.1f ns x %-8llu event %8.1f ns x %-7llu deferred %8.1f ns x %-6llu total %.3f ms", "", result.idle.average_ns(), static_cast<unsigned long long>(result.idle.scans), result.event.average_ns(), static_cast<unsigned long long>(result.event.scans), result.deferred.average_ns(), static_cast<unsigned long long>(result.deferred.scans), result.total().count() / 1e6);
+    if (baseline && baseline != &result) {
+        std::printf("  (%s: %+.3f ms)", baseline->variant.c_str(), (baseline->total() - result.total()).count() / 1e6);
+    }
+    std::printf("\n");
+}
+
+} // namespace
+
+extern "C" bool process_record_user(uint16_t keycode, keyrecord_t *record) {
+    records_processed++;
+    return true;
+}
+
+class Benchmark : public TestFixture {
+   public:
+    void SetUp() override {
+        set_keymap_variant(true);
+        autocorrect_enable();
+        combo_enable();
+    }
+
+    void set_keymap_variant(bool tap_hold) {
+        keymap.clear();
+        layer0 = {};
+        for (const auto &key : benchmark_layout) {
+            add_key(KeymapKey(0, key.col, key.row, tap_hold ? key.keycode : key.plain_keycode));
+            layer0[key.row][key.col] = tap_hold ? key.keycode : key.plain_keycode;
+        }
+    }
+
+    /* Reads layer 0 from a flat array like a real keymap does, so the fixture's keymap search stays out of the timings. */
+    void get_keycode(const layer_t layer, const keypos_t position, uint16_t *result) const override {
+        if (layer == 0 && position.row < MATRIX_ROWS && position.col < MATRIX_COLS && layer0[position.row][position.col] != KC_NO) {
+            *result = layer0[position.row][position.col];
+            return;
+        }
+        TestFixture::get_keycode(layer, position, result);
+    }
+
+    /* Keeps the fastest of QMK_BENCHMARK_REPEAT runs (default 3) to filter out host scheduling noise. */
+    BenchmarkResult best_of(const std::string &variant, const Corpus &corpus) {
+        BenchmarkResult best    = run(variant, corpus);
+        size_t          repeats = environment_or("QMK_BENCHMARK_REPEAT", 3);
+        for (size_t i = 1; i < repeats; i++) {
+            BenchmarkResult result = run(variant, corpus);
+            if (result.total() < best.total()) {
+                best = result;
+            }
+        }
+        return best;
+    }
+
+    /* Runs the whole corpus through keyboard_task(), one scan per simulated millisecond. */
+    BenchmarkResult run(const std::string &variant, const Corpus &corpus) {
+        BenchmarkResult result = {};
+        result.variant         = variant;
+        result.events          = corpus.events.size();
+
+        host_set_driver(&benchmark_driver);
+        host_counters     = {};
+        records_processed = 0;
+
+        for (const auto &event : corpus.events) {
+            for (uint16_t i = 0; i < event.delay_ms; i++) {
+                scan(result, false);
+            }
+            if (event.pressed) {
+                press_key(event.col, event.row);
+            } else {
+                release_key(event.col, event.row);
+            }
+            scan(result, true);
+        }
+        // Drain tapping, combo and autocorrect state before the fixture checks for silence
+        for (uint16_t i = 0; i < TAPPING_TERM * 2; i++) {
+            scan(result, false);
+        }
+
+        result.reports = host_counters;
+        result.records = records_processed;
+        return result;
+    }
+
+   private:
+    std::array<std::array<uint16_t, MATRIX_COLS>, MATRIX_ROWS> layer0;
+
+    void scan(BenchmarkResult &result, bool matrix_changed) {
+        uint32_t reports_before = host_counters.total();
+
+        auto start = clock_type::now();
+        keyboard_task();
+        auto elapsed = clock_type::now() - start;
+
+        StageTime &stage = matrix_changed ? result.event : (host_counters.total() != reports_before ? result.deferred : result.idle);
+        stage.scans++;
+        stage.time += std::chrono::duration_cast<nanoseconds>(elapsed);
+        advance_time(1);
+    }
+};
+
+TEST_F(Benchmark, TypingCorpusThroughput) {
+    const Corpus &corpus = benchmark_corpus();
+    ASSERT_FALSE(corpus.events.empty());
+
+    std::printf("[ BENCH    ] corpus %s: %zu events over %.1f s of typing\n", corpus.name.c_str(), corpus.events.size(), corpus.duration_ms() / 1000.0);
+
+    BenchmarkResult full = best_of("full", corpus);
+    print_result(full, nullptr);
+
+    autocorrect_disable();
+    BenchmarkResult no_autocorrect = best_of("-autocorrect", corpus);
+    print_result(no_autocorrect, &full);
+    autocorrect_enable();
+
+    combo_disable();
+    BenchmarkResult no_combo = best_of("-combo", corpus);
+    print_result(no_combo, &full);
+    combo_enable();
+
+    set_keymap_variant(false);
+    BenchmarkResult no_tap_hold = best_of("-tap_hold", corpus);
+    print_result(no_tap_hold, &full);
+
+    autocorrect_disable();
+    combo_disable();
+    BenchmarkResult bare = best_of("bare", corpus);
+    print_result(bare, &full);
+    autocorrect_enable();
+    combo_enable();
+
+    // Every matrix transition must reach the keymap and produce output in every variant
+    for (const auto *result : {&full, &no_autocorrect, &no_combo, &no_tap_hold, &bare}) {
+        EXPECT_GT(result->reports.keyboard, 0u) << result->variant;
+        EXPECT_EQ(result->event.scans, result->events) << result->variant;
+        EXPECT_FALSE(result->records == 0) << result->variant;
+    }
+    // With nothing buffered or rewritten, each press and release becomes exactly one record
+    EXPECT_EQ(bare.records, bare.events);
+
+    clear_all_keys();
+}
@@ -0,0 +1,10 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define DYNAMIC_MACRO_EEPROM_STORAGE
+#define DYNAMIC_MACRO_EEPROM_SIZE 64
+#define DYNAMIC_MACRO_EEPROM_CHUNK_SIZE 8
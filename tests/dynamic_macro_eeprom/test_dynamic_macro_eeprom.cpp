@@ -0,0 +1,149 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keycode.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "eeprom.h"
+}
+
+using ::testing::_;
+using ::testing::AnyNumber;
+using ::testing::Between;
+using ::testing::InSequence;
+
+#define DYNAMIC_MACRO_DATA_SIZE (DYNAMIC_MACRO_EEPROM_SIZE - 6)
+
+class DynamicMacroEeprom : public TestFixture {
+   public:
+    KeymapKey key_rec1 = KeymapKey(0, 0, 0, DM_REC1);
+    KeymapKey key_rec2 = KeymapKey(0, 1, 0, DM_REC2);
+    KeymapKey key_stop = KeymapKey(0, 2, 0, DM_RSTP);
+    KeymapKey key_ply1 = KeymapKey(0, 3, 0, DM_PLY1);
+    KeymapKey key_ply2 = KeymapKey(0, 4, 0, DM_PLY2);
+    KeymapKey key_a    = KeymapKey(0, 5, 0, KC_A);
+    KeymapKey key_b    = KeymapKey(0, 6, 0, KC_B);
+    KeymapKey key_c    = KeymapKey(0, 7, 0, KC_C);
+    KeymapKey key_lsft = KeymapKey(0, 8, 0, KC_LSFT);
+
+    void SetUp() override {
+        set_keymap({key_rec1, key_rec2, key_stop, key_ply1, key_ply2, key_a, key_b, key_c, key_lsft});
+    }
+
+    uint16_t stored_word(uint8_t index) {
+        return eeprom_read_word((const uint16_t *)(DYNAMIC_MACRO_EEPROM_ADDR) + index);
+    }
+};
+
+TEST_F(DynamicMacroEeprom, RecordedMacroIsPlayedBackFromStorage) {
+    TestDriver driver;
+
+    EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+    {
+        InSequence seq;
+        // Recording
+        EXPECT_REPORT(driver, (KC_A));
+        EXPECT_REPORT(driver, (KC_B));
+        // Playback
+        EXPECT_REPORT(driver, (KC_A));
+        EXPECT_REPORT(driver, (KC_B));
+    }
+
+    tap_key(key_rec1);
+    tap_keys(key_a, key_b);
+    tap_key(key_stop);
+
+    EXPECT_EQ(stored_word(0), 0x4D01);
+    EXPECT_GT(stored_word(1), 0);
+    // Each tap is a press and a release of a handful of bytes each
+    EXPECT_LE(stored_word(1), 2 * 2 * 8);
+
+    tap_key(key_ply1);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicMacroEeprom, BothMacrosShareTheStorage) {
+    TestDriver driver;
+
+    EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+    {
+        InSequence seq;
+        // Recording
+        EXPECT_REPORT(driver, (KC_A));
+        EXPECT_REPORT(driver, (KC_B));
+        EXPECT_REPORT(driver, (KC_C));
+        // Playback of macro 2, then macro 1
+        EXPECT_REPORT(driver, (KC_B));
+        EXPECT_REPORT(driver, (KC_C));
+        EXPECT_REPORT(driver, (KC_A));
+    }
+
+    tap_key(key_rec1);
+    tap_key(key_a);
+    tap_key(key_stop);
+
+    tap_key(key_rec2);
+    tap_keys(key_b, key_c);
+    tap_key(key_stop);
+
+    EXPECT_GT(stored_word(1), 0);
+    EXPECT_GT(stored_word(2), stored_word(1));
+
+    tap_key(key_ply2);
+    tap_key(key_ply1);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicMacroEeprom, KeysHeldWhenStoppingAreTrimmed) {
+    TestDriver driver;
+
+    EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+    {
+        InSequence seq;
+        // Recording
+        EXPECT_REPORT(driver, (KC_A));
+        EXPECT_REPORT(driver, (KC_LSFT));
+        // Playback, without the shift still held at the end of the recording
+        EXPECT_REPORT(driver, (KC_A));
+    }
+
+    tap_key(key_rec1);
+    tap_key(key_a);
+    key_lsft.press();
+    run_one_scan_loop();
+    tap_key(key_stop);
+    key_lsft.release();
+    run_one_scan_loop();
+
+    tap_key(key_ply1);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicMacroEeprom, EventsBeyondTheStorageAreDropped) {
+    TestDriver driver;
+
+    // Free up the space taken by macro 2 in the previous tests
+    EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+    tap_key(key_rec2);
+    tap_key(key_stop);
+    EXPECT_EQ(stored_word(2), 0);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+    EXPECT_REPORT(driver, (KC_A)).Times(20);
+    tap_key(key_rec1);
+    for (int i = 0; i < 20; i++) {
+        tap_key(key_a);
+    }
+    tap_key(key_stop);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_LE(stored_word(1), DYNAMIC_MACRO_DATA_SIZE);
+
+    // Only the taps that fit are played back, and the macro still ends on a release
+    EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+    EXPECT_REPORT(driver, (KC_A)).Times(Between(1, 19));
+    tap_key(key_ply1);
+    VERIFY_AND_CLEAR(driver);
+}
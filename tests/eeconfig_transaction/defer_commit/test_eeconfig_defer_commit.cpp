@@ -0,0 +1,50 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "test_common.hpp"
+
+extern "C" {
+#include "eeconfig.h"
+}
+
+class EeconfigDeferCommit : public TestFixture {
+   public:
+    void SetUp() override {
+        eeconfig_flush();
+    }
+};
+
+TEST_F(EeconfigDeferCommit, writes_are_flushed_once_idle) {
+    TestDriver driver;
+    uint16_t keymap = eeprom_read_word(EECONFIG_KEYMAP);
+
+    eeconfig_update_keymap(keymap ^ 0x0001);
+    idle_for(EECONFIG_DEFER_COMMIT_MS / 2);
+    EXPECT_EQ(eeprom_read_word(EECONFIG_KEYMAP), keymap);
+
+    // Each write pushes the flush back
+    eeconfig_update_keymap(keymap ^ 0x0002);
+    idle_for(EECONFIG_DEFER_COMMIT_MS / 2 + 10);
+    EXPECT_EQ(eeprom_read_word(EECONFIG_KEYMAP), keymap);
+    EXPECT_EQ(eeconfig_read_keymap(), keymap ^ 0x0002);
+
+    idle_for(EECONFIG_DEFER_COMMIT_MS);
+    EXPECT_EQ(eeprom_read_word(EECONFIG_KEYMAP), keymap ^ 0x0002);
+}
+
+TEST_F(EeconfigDeferCommit, commit_is_left_to_the_task) {
+    TestDriver driver;
+    eeconfig_update_default_layer(0);
+    eeconfig_flush();
+
+    eeconfig_begin();
+    eeconfig_update_default_layer(1);
+    idle_for(EECONFIG_DEFER_COMMIT_MS * 2);
+    // Not while the transaction is open
+    EXPECT_EQ(eeprom_read_byte(EECONFIG_DEFAULT_LAYER), 0);
+
+    eeconfig_commit();
+    EXPECT_EQ(eeprom_read_byte(EECONFIG_DEFAULT_LAYER), 0);
+    idle_for(EECONFIG_DEFER_COMMIT_MS + 1);
+    EXPECT_EQ(eeprom_read_byte(EECONFIG_DEFAULT_LAYER), 1);
+}
@@ -0,0 +1,75 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "test_common.hpp"
+
+extern "C" {
+#include "eeconfig.h"
+}
+
+class EeconfigTransaction : public TestFixture {};
+
+TEST_F(EeconfigTransaction, writes_are_held_until_commit) {
+    eeconfig_update_keymap(0x0000);
+
+    eeconfig_begin();
+    eeconfig_update_keymap(0x1234);
+    EXPECT_EQ(eeprom_read_word(EECONFIG_KEYMAP), 0x0000);
+    EXPECT_EQ(eeconfig_read_keymap(), 0x1234);
+
+    eeconfig_commit();
+    EXPECT_EQ(eeprom_read_word(EECONFIG_KEYMAP), 0x1234);
+}
+
+TEST_F(EeconfigTransaction, nested_transactions_commit_once) {
+    eeconfig_update_default_layer(0);
+
+    eeconfig_begin();
+    eeconfig_begin();
+    eeconfig_update_default_layer(3);
+    eeconfig_commit();
+    EXPECT_EQ(eeprom_read_byte(EECONFIG_DEFAULT_LAYER), 0);
+
+    eeconfig_commit();
+    EXPECT_EQ(eeprom_read_byte(EECONFIG_DEFAULT_LAYER), 3);
+}
+
+TEST_F(EeconfigTransaction, only_the_changed_range_is_written) {
+    eeconfig_update_default_layer(0);
+    eeconfig_update_handedness(false);
+
+    eeconfig_begin();
+    eeconfig_update_default_layer(2);
+    // Written around the transaction, outside of what it changed
+    eeprom_update_byte(EECONFIG_HANDEDNESS, 1);
+    eeconfig_commit();
+
+    EXPECT_EQ(eeprom_read_byte(EECONFIG_DEFAULT_LAYER), 2);
+    EXPECT_EQ(eeprom_read_byte(EECONFIG_HANDEDNESS), 1);
+}
+
+TEST_F(EeconfigTransaction, writes_past_the_core_block_are_not_held) {
+    uint8_t *addr  = (uint8_t *)(EECONFIG_BASE_SIZE);
+    uint8_t  value = 0x5A;
+
+    eeprom_update_byte(addr, 0);
+
+    eeconfig_begin();
+    eeconfig_update_block(&value, addr, sizeof(value));
+    EXPECT_EQ(eeprom_read_byte(addr), 0x5A);
+    eeconfig_commit();
+}
+
+TEST_F(EeconfigTransaction, flush_writes_with_a_transaction_open) {
+    eeconfig_update_debug(0);
+
+    eeconfig_begin();
+    eeconfig_update_debug(1);
+    eeconfig_flush();
+    EXPECT_EQ(eeprom_read_byte(EECONFIG_DEBUG), 1);
+
+    eeconfig_update_debug(0);
+    EXPECT_EQ(eeprom_read_byte(EECONFIG_DEBUG), 1);
+    eeconfig_commit();
+    EXPECT_EQ(eeprom_read_byte(EECONFIG_DEBUG), 0);
+}
@@ -0,0 +1,102 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+class LayerTransparencyMask : public TestFixture {};
+
+TEST_F(LayerTransparencyMask, ResolvesTopmostNonTransparentLayer) {
+    TestDriver driver;
+    KeymapKey  key_base   = KeymapKey(0, 0, 0, KC_A);
+    KeymapKey  key_middle = KeymapKey(1, 0, 0, KC_B);
+    KeymapKey  key_top    = KeymapKey(2, 0, 0, KC_TRNS);
+
+    set_keymap({key_base, key_middle, key_top});
+
+    layer_state_set(0);
+    EXPECT_EQ(layer_switch_get_layer(key_base.position), 0);
+
+    layer_on(2);
+    EXPECT_EQ(layer_switch_get_layer(key_base.position), 0);
+
+    layer_on(1);
+    EXPECT_EQ(layer_switch_get_layer(key_base.position), 1);
+
+    layer_off(1);
+    layer_off(2);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LayerTransparencyMask, FallsBackToLayerZero) {
+    TestDriver driver;
+    KeymapKey  key_top = KeymapKey(3, 0, 0, KC_TRNS);
+
+    set_keymap({key_top});
+
+    layer_on(3);
+    EXPECT_EQ(layer_switch_get_layer(key_top.position), 0);
+
+    layer_off(3);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LayerTransparencyMask, MatchesLayerWalkOnEveryLayerCombination) {
+    TestDriver driver;
+
+    /* A different mix of transparent and opaque layers on every key of the first row */
+    for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+        for (uint8_t layer = 0; layer < 4; layer++) {
+            add_key(KeymapKey(layer, col, 0, (col >> layer) & 1 ? KC_A : KC_TRNS));
+        }
+    }
+
+    for (layer_state_t state = 0; state < 16; state++) {
+        layer_state_set(state);
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            keypos_t key      = {.col = col, .row = 0};
+            uint8_t  expected = 0;
+            for (int8_t layer = 3; layer >= 0; layer--) {
+                if ((state & ((layer_state_t)1 << layer)) && (col >> layer) & 1) {
+                    expected = layer;
+                    break;
+                }
+            }
+            EXPECT_EQ(layer_switch_get_layer(key), expected) << "layer state " << +state << ", column " << +col;
+        }
+    }
+
+    layer_clear();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LayerTransparencyMask, UpdatesAfterKeymapChange) {
+    TestDriver driver;
+    KeymapKey  key_base = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key_base});
+
+    layer_on(1);
+    EXPECT_EQ(layer_switch_get_layer(key_base.position), 0);
+
+    /* Adding a key invalidates the mask, so the new layer 1 mapping takes effect */
+    KeymapKey key_layer = KeymapKey(1, 0, 0, KC_B);
+    add_key(key_layer);
+    EXPECT_EQ(layer_switch_get_layer(key_base.position), 1);
+
+    EXPECT_REPORT(driver, (key_layer.report_code));
+    key_layer.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_layer.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    layer_off(1);
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,6 @@
+#pragma once
+
+#include "test_common.h"
+
+#define LEADER_SEQUENCE_TABLE
+#define LEADER_AUTO_COMPLETE
@@ -0,0 +1,5 @@
+#pragma once
+
+#include "test_common.h"
+
+#define LEADER_SEQUENCE_TABLE
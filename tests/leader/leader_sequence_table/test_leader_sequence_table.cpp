@@ -0,0 +1,100 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+
+class Leader : public TestFixture {};
+
+TEST_F(Leader, matches_prefix_sequence_on_timeout) {
+    TestDriver driver;
+
+    auto key_leader = KeymapKey(0, 0, 0, QK_LEADER);
+    auto key_a      = KeymapKey(0, 1, 0, KC_A);
+
+    set_keymap({key_leader, key_a});
+
+    tap_key(key_leader);
+
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_a);
+
+    EXPECT_EQ(leader_sequence_active(), true);
+
+    EXPECT_REPORT(driver, (KC_1));
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(300);
+
+    EXPECT_EQ(leader_sequence_active(), false);
+}
+
+TEST_F(Leader, ends_on_unambiguous_match) {
+    TestDriver driver;
+
+    auto key_leader = KeymapKey(0, 0, 0, QK_LEADER);
+    auto key_a      = KeymapKey(0, 1, 0, KC_A);
+    auto key_b      = KeymapKey(0, 2, 0, KC_B);
+
+    set_keymap({key_leader, key_a, key_b});
+
+    tap_key(key_leader);
+
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_a);
+
+    EXPECT_REPORT(driver, (KC_2));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_b);
+
+    EXPECT_EQ(leader_sequence_active(), false);
+
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_b);
+}
+
+TEST_F(Leader, matches_sequence_regardless_of_table_order) {
+    TestDriver driver;
+
+    auto key_leader = KeymapKey(0, 0, 0, QK_LEADER);
+    auto key_x      = KeymapKey(0, 1, 0, KC_X);
+    auto key_y      = KeymapKey(0, 2, 0, KC_Y);
+
+    set_keymap({key_leader, key_x, key_y});
+
+    tap_key(key_leader);
+
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_x);
+
+    EXPECT_REPORT(driver, (KC_3));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_y);
+
+    EXPECT_EQ(leader_sequence_active(), false);
+}
+
+TEST_F(Leader, ends_early_when_nothing_can_match) {
+    TestDriver driver;
+
+    auto key_leader = KeymapKey(0, 0, 0, QK_LEADER);
+    auto key_a      = KeymapKey(0, 1, 0, KC_A);
+    auto key_q      = KeymapKey(0, 2, 0, KC_Q);
+
+    set_keymap({key_leader, key_a, key_q});
+
+    tap_key(key_leader);
+
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_q);
+
+    EXPECT_EQ(leader_sequence_active(), false);
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_a);
+}
@@ -0,0 +1,12 @@
+# Copyright 2023 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+# --------------------------------------------------------------------------------
+# Keep this file, even if it is empty, as a marker that this folder contains tests
+# --------------------------------------------------------------------------------
+
+RAW_HID_ROUTER_ENABLE = yes
+
+# via.c needs generated headers, so the test provides the VIA functions the core
+# calls and checks the router the way VIA keyboards use it
+OPT_DEFS += -DVIA_ENABLE
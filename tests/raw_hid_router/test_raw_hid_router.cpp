@@ -0,0 +1,192 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+#include "test_common.hpp"
+
+extern "C" {
+#include "raw_hid.h"
+#include "via.h"
+}
+
+#define ID_VIA_COMMAND_KB 0x20
+
+static bool                 host_ready = true;
+static std::vector<uint8_t> sent;
+static std::vector<uint8_t> handled_by_core;
+static std::vector<uint8_t> handled_by_kb;
+static std::vector<uint8_t> handled_by_multi;
+static std::vector<uint8_t> seen_by_via_command_kb;
+
+extern "C" {
+void raw_hid_send(uint8_t *data, uint8_t length) {
+    sent.push_back(data[0]);
+}
+
+bool raw_hid_send_ready(void) {
+    return host_ready;
+}
+
+bool via_command_kb(uint8_t *data, uint8_t length) {
+    seen_by_via_command_kb.push_back(data[0]);
+    if (data[0] == ID_VIA_COMMAND_KB) {
+        raw_hid_send(data, length);
+        return true;
+    }
+    return false;
+}
+
+void via_init(void) {}
+
+bool process_record_via(uint16_t keycode, keyrecord_t *record) {
+    return true;
+}
+
+bool via_eeprom_is_valid(void) {
+    return true;
+}
+
+void via_eeprom_set_valid(bool valid) {}
+
+void eeconfig_init_via(void) {}
+}
+
+static bool core_command(uint8_t *data, uint8_t length) {
+    handled_by_core.push_back(data[0]);
+    return true;
+}
+
+/* Replies straight through raw_hid_send(), like a via_command_kb() override. */
+static bool kb_command(uint8_t *data, uint8_t length) {
+    handled_by_kb.push_back(data[0]);
+    raw_hid_send(data, length);
+    return false;
+}
+
+/* Queues a response of four reports ahead of the reply, filling the send queue. */
+static bool multi_command(uint8_t *data, uint8_t length) {
+    handled_by_multi.push_back(data[0]);
+    for (uint8_t i = 0; i < 4; i++) {
+        uint8_t report[32] = {(uint8_t)(0x90 + i)};
+        raw_hid_send_async(report, sizeof(report));
+    }
+    return true;
+}
+
+class RawHidRouter : public TestFixture {
+   public:
+    static void SetUpTestCase() {
+        TestFixture::SetUpTestCase();
+        raw_hid_register_handler(0x01, 0x3F, core_command);
+        raw_hid_register_handler(0x30, 0x3F, kb_command);
+        raw_hid_register_handler(0x40, 0x4F, multi_command);
+    }
+
+    void SetUp() override {
+        host_ready = true;
+        sent.clear();
+        handled_by_core.clear();
+        handled_by_kb.clear();
+        handled_by_multi.clear();
+        seen_by_via_command_kb.clear();
+    }
+
+    void TearDown() override {
+        // Leave both queues empty for the next test
+        host_ready = true;
+        raw_hid_router_task();
+        TestFixture::TearDown();
+    }
+
+    void receive(uint8_t id) {
+        uint8_t data[32] = {id};
+        raw_hid_receive(data, sizeof(data));
+    }
+
+    void send_async(uint8_t id) {
+        uint8_t data[32] = {id};
+        EXPECT_TRUE(raw_hid_send_async(data, sizeof(data)));
+    }
+};
+
+TEST_F(RawHidRouter, later_registration_takes_precedence) {
+    receive(0x10);
+    receive(0x35);
+
+    EXPECT_EQ(handled_by_core, std::vector<uint8_t>({0x10}));
+    EXPECT_EQ(handled_by_kb, std::vector<uint8_t>({0x35}));
+    EXPECT_EQ(sent, std::vector<uint8_t>({0x10, 0x35}));
+}
+
+TEST_F(RawHidRouter, unrouted_commands_are_answered_as_unhandled) {
+    receive(0x00);
+    receive(0x80);
+
+    EXPECT_TRUE(handled_by_core.empty());
+    EXPECT_EQ(sent, std::vector<uint8_t>({id_unhandled, id_unhandled}));
+}
+
+TEST_F(RawHidRouter, via_command_kb_sees_every_command) {
+    receive(0x10);
+    receive(0x35);
+    receive(0x80);
+    receive(ID_VIA_COMMAND_KB);
+
+    EXPECT_EQ(seen_by_via_command_kb, std::vector<uint8_t>({0x10, 0x35, 0x80, ID_VIA_COMMAND_KB}));
+    EXPECT_EQ(handled_by_core, std::vector<uint8_t>({0x10}));
+    EXPECT_EQ(sent, std::vector<uint8_t>({0x10, 0x35, id_unhandled, ID_VIA_COMMAND_KB}));
+}
+
+TEST_F(RawHidRouter, replies_are_queued_until_the_host_is_ready) {
+    host_ready = false;
+    receive(0x10);
+    raw_hid_router_task();
+    EXPECT_EQ(handled_by_core, std::vector<uint8_t>({0x10}));
+    EXPECT_TRUE(sent.empty());
+
+    host_ready = true;
+    raw_hid_router_task();
+    EXPECT_EQ(sent, std::vector<uint8_t>({0x10}));
+}
+
+TEST_F(RawHidRouter, commands_wait_for_queued_reports) {
+    host_ready = false;
+    send_async(0x80);
+    receive(0x35);
+    EXPECT_TRUE(handled_by_kb.empty());
+
+    host_ready = true;
+    raw_hid_router_task();
+    EXPECT_EQ(handled_by_kb, std::vector<uint8_t>({0x35}));
+    EXPECT_EQ(sent, std::vector<uint8_t>({0x80, 0x35}));
+}
+
+TEST_F(RawHidRouter, full_send_queue_waits_for_the_host) {
+    host_ready = false;
+    receive(0x40);
+
+    // The reply does not fit behind the four queued reports, so those are sent first
+    EXPECT_EQ(handled_by_multi, std::vector<uint8_t>({0x40}));
+    EXPECT_EQ(sent, std::vector<uint8_t>({0x90, 0x91, 0x92, 0x93}));
+
+    host_ready = true;
+    raw_hid_router_task();
+    EXPECT_EQ(sent, std::vector<uint8_t>({0x90, 0x91, 0x92, 0x93, 0x40}));
+}
+
+TEST_F(RawHidRouter, full_receive_queue_waits_for_the_host) {
+    host_ready = false;
+    send_async(0x80);
+
+    // Two commands wait for the queued report, the third one makes them all run in order
+    receive(0x10);
+    receive(0x11);
+    EXPECT_TRUE(handled_by_core.empty());
+    receive(0x12);
+    EXPECT_EQ(handled_by_core, std::vector<uint8_t>({0x10, 0x11, 0x12}));
+    EXPECT_EQ(sent, std::vector<uint8_t>({0x80, 0x10, 0x11}));
+
+    host_ready = true;
+    raw_hid_router_task();
+    EXPECT_EQ(sent, std::vector<uint8_t>({0x80, 0x10, 0x11, 0x12}));
+}
@@ -0,0 +1,118 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "send_string.h"
+}
+
+using testing::_;
+using testing::InSequence;
+
+static std::vector<bool> finished;
+
+static void record_finished(bool completed, void *cb_arg) {
+    finished.push_back(completed);
+}
+
+class SendStringAsync : public TestFixture {
+   public:
+    void SetUp() override {
+        send_string_async_cancel();
+        finished.clear();
+    }
+};
+
+TEST_F(SendStringAsync, types_one_key_event_per_report) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT, KC_B));
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_TRUE(send_string_async("aB", 0, record_finished, NULL));
+    EXPECT_TRUE(send_string_async_busy());
+    idle_for(20);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_FALSE(send_string_async_busy());
+    EXPECT_EQ(finished, std::vector<bool>({true}));
+}
+
+TEST_F(SendStringAsync, waits_interval_between_key_events) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_REPORT(driver, (KC_A));
+    send_string_async("a", 50, NULL, NULL);
+    idle_for(49);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(2);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringAsync, long_delay_holds_off_the_next_key) {
+    TestDriver driver;
+    InSequence s;
+
+    // Longer than half the range of a 16 bit timer
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    send_string_async("a" SS_DELAY(40000) "b", 0, NULL, NULL);
+    idle_for(39000);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(2000);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringAsync, rejects_strings_when_the_queue_is_full) {
+    TestDriver driver;
+
+    EXPECT_ANY_REPORT(driver).Times(testing::AnyNumber());
+    for (int i = 0; i < 4; i++) {
+        EXPECT_TRUE(send_string_async("a", 0, record_finished, NULL));
+    }
+    EXPECT_FALSE(send_string_async("a", 0, record_finished, NULL));
+
+    // The string being typed has left the queue
+    run_one_scan_loop();
+    EXPECT_TRUE(send_string_async("a", 0, record_finished, NULL));
+    idle_for(50);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(finished, std::vector<bool>(5, true));
+}
+
+TEST_F(SendStringAsync, cancel_releases_keys_and_drops_queued_strings) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT, KC_A));
+    send_string_async("A", 0, record_finished, NULL);
+    send_string_async("b", 0, record_finished, NULL);
+    run_one_scan_loop();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    EXPECT_EMPTY_REPORT(driver);
+    send_string_async_cancel();
+    idle_for(20);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_FALSE(send_string_async_busy());
+    EXPECT_EQ(finished, std::vector<bool>({false, false}));
+}
@@ -0,0 +1,79 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string>
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "send_string.h"
+#include "keycode_config.h"
+
+uint8_t keyboard_protocol = 1;
+}
+
+using testing::_;
+using testing::Invoke;
+
+class NkroPacking : public TestFixture {
+   public:
+    std::vector<report_nkro_t> reports;
+
+    void record_nkro_reports(TestDriver &driver) {
+        EXPECT_CALL(driver, send_nkro_mock(_)).WillRepeatedly(Invoke([this](report_nkro_t &report) { reports.push_back(report); }));
+    }
+
+    /* Types out the recorded reports like a host would, reading each report's new keys in usage order. */
+    std::string typed_text(void) {
+        std::string   text;
+        report_nkro_t previous = {};
+        for (auto &report : reports) {
+            bool shifted = report.mods & MOD_BIT(KC_LEFT_SHIFT);
+            for (uint8_t code = 0; code < NKRO_REPORT_BITS * 8; code++) {
+                bool pressed     = report.bits[code >> 3] & (1 << (code & 7));
+                bool was_pressed = previous.bits[code >> 3] & (1 << (code & 7));
+                if (!pressed || was_pressed) {
+                    continue;
+                }
+                if (code >= KC_A && code <= KC_Z) {
+                    text += (shifted ? 'A' : 'a') + (code - KC_A);
+                } else if (code == KC_ENTER) {
+                    text += '\n';
+                } else {
+                    text += '?';
+                }
+            }
+            previous = report;
+        }
+        return text;
+    }
+};
+
+TEST_F(NkroPacking, packs_runs_of_characters_into_shared_reports) {
+    TestDriver driver;
+
+    keymap_config.nkro = true;
+    record_nkro_reports(driver);
+    EXPECT_NO_REPORT(driver);
+
+    send_string_async("abcABba\nHello", 0, NULL, NULL);
+    idle_for(100);
+
+    EXPECT_EQ(typed_text(), "abcABba\nHello");
+    // One report pair per character would take 32 reports
+    EXPECT_EQ(reports.size(), 18);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(NkroPacking, sends_one_character_per_report_pair_without_nkro) {
+    TestDriver driver;
+
+    keymap_config.nkro = false;
+    EXPECT_CALL(driver, send_nkro_mock(_)).Times(0);
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(32);
+
+    send_string_async("abcABba\nHello", 0, NULL, NULL);
+    idle_for(100);
+    VERIFY_AND_CLEAR(driver);
+}
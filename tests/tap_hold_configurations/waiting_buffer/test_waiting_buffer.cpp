@@ -0,0 +1,120 @@
+/* Copyright 2023 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "action_tapping.h"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::AnyNumber;
+using testing::InSequence;
+
+class WaitingBuffer : public TestFixture {
+   public:
+    void SetUp() override {
+        action_tapping_reset_stats();
+    }
+};
+
+TEST_F(WaitingBuffer, taps_beyond_default_buffer_size_are_kept_while_mod_tap_key_is_held) {
+    TestDriver driver;
+    InSequence s;
+    auto       mod_tap_hold_key = KeymapKey(0, 0, 0, SFT_T(KC_P));
+
+    std::vector<KeymapKey> regular_keys;
+    for (uint8_t col = 1; col <= 7; col++) {
+        regular_keys.emplace_back(0, col, 0, KC_A + col);
+    }
+
+    set_keymap({mod_tap_hold_key});
+    for (auto &key : regular_keys) {
+        add_key(key);
+    }
+
+    /* Press mod-tap-hold key. */
+    EXPECT_NO_REPORT(driver);
+    mod_tap_hold_key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    /* Tap seven regular keys, 14 events in a 16 slot buffer. */
+    EXPECT_NO_REPORT(driver);
+    for (auto &key : regular_keys) {
+        key.press();
+        run_one_scan_loop();
+        key.release();
+        run_one_scan_loop();
+    }
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(action_tapping_waiting_buffer_peak(), 14);
+
+    /* Release mod-tap-hold key, every buffered tap is replayed. */
+    EXPECT_REPORT(driver, (KC_P));
+    for (auto &key : regular_keys) {
+        EXPECT_REPORT(driver, (KC_P, key.code));
+        EXPECT_REPORT(driver, (KC_P));
+    }
+    EXPECT_EMPTY_REPORT(driver);
+    mod_tap_hold_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(action_tapping_overflow_count(), 0);
+}
+
+TEST_F(WaitingBuffer, overflow_clears_state_and_is_counted) {
+    TestDriver driver;
+    auto       mod_tap_hold_key = KeymapKey(0, 0, 0, SFT_T(KC_P));
+
+    std::vector<KeymapKey> regular_keys;
+    for (uint8_t col = 1; col <= 8; col++) {
+        regular_keys.emplace_back(0, col, 0, KC_A + col);
+    }
+
+    set_keymap({mod_tap_hold_key});
+    for (auto &key : regular_keys) {
+        add_key(key);
+    }
+
+    /* Press mod-tap-hold key. */
+    EXPECT_NO_REPORT(driver);
+    mod_tap_hold_key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    /* Tap eight regular keys, the 16th event does not fit. */
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    for (auto &key : regular_keys) {
+        key.press();
+        run_one_scan_loop();
+        key.release();
+        run_one_scan_loop();
+    }
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(action_tapping_overflow_count(), 1);
+    EXPECT_EQ(action_tapping_waiting_buffer_peak(), WAITING_BUFFER_SIZE - 1);
+
+    /* The mod-tap-hold key was forgotten, its release does nothing. */
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    mod_tap_hold_key.release();
+    run_one_scan_loop();
+    idle_for(TAPPING_TERM);
+    VERIFY_AND_CLEAR(driver);
+}
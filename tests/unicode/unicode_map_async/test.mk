@@ -0,0 +1,6 @@
+# --------------------------------------------------------------------------------
+# Keep this file, even if it is empty, as a marker that this folder contains tests
+# --------------------------------------------------------------------------------
+
+UNICODEMAP_ENABLE = yes
+SEND_STRING_ASYNC_ENABLE = yes
@@ -0,0 +1,173 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+const uint32_t PROGMEM unicode_map[] = {
+    0x03A8, // Ψ
+    0x2318  // ⌘
+};
+
+class UnicodeMapAsync : public TestFixture {
+   public:
+    /* The Linux input sequence as typed by send_string, one key per report. */
+    void expect_async_unicode(TestDriver &driver, std::vector<uint8_t> digits) {
+        EXPECT_REPORT(driver, (KC_LEFT_CTRL));
+        EXPECT_REPORT(driver, (KC_LEFT_CTRL, KC_LEFT_SHIFT));
+        EXPECT_REPORT(driver, (KC_LEFT_CTRL, KC_LEFT_SHIFT, KC_U));
+        EXPECT_REPORT(driver, (KC_LEFT_CTRL, KC_LEFT_SHIFT));
+        EXPECT_REPORT(driver, (KC_LEFT_CTRL));
+        EXPECT_EMPTY_REPORT(driver);
+        for (uint8_t digit : digits) {
+            EXPECT_REPORT(driver, (digit));
+            EXPECT_EMPTY_REPORT(driver);
+        }
+        EXPECT_REPORT(driver, (KC_SPACE));
+        EXPECT_EMPTY_REPORT(driver);
+    }
+};
+
+TEST_F(UnicodeMapAsync, sends_unicodemap_code_point_in_the_background) {
+    TestDriver driver;
+    InSequence s;
+
+    auto key_um = KeymapKey(0, 0, 0, UM(0));
+
+    set_keymap({key_um});
+
+    expect_async_unicode(driver, {KC_0, KC_3, KC_A, KC_8});
+    tap_key(key_um);
+    idle_for(100);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(UnicodeMapAsync, restores_modifiers_held_for_a_pair) {
+    TestDriver driver;
+    InSequence s;
+
+    auto key_shift = KeymapKey(0, 0, 0, KC_LEFT_SHIFT);
+    auto key_up    = KeymapKey(0, 1, 0, UP(0, 1));
+
+    set_keymap({key_shift, key_up});
+
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    key_shift.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    /* Shift is released for the sequence and comes back once it is done. */
+    EXPECT_EMPTY_REPORT(driver);
+    expect_async_unicode(driver, {KC_2, KC_3, KC_1, KC_8});
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    tap_key(key_up);
+    idle_for(100);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_shift.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(UnicodeMapAsync, does_not_restore_modifiers_released_meanwhile) {
+    TestDriver driver;
+    InSequence s;
+
+    auto key_shift = KeymapKey(0, 0, 0, KC_LEFT_SHIFT);
+    auto key_up    = KeymapKey(0, 1, 0, UP(0, 1));
+
+    set_keymap({key_shift, key_up});
+
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    key_shift.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    /* The release happens in the middle of the sequence without showing up in it. */
+    EXPECT_EMPTY_REPORT(driver);
+    expect_async_unicode(driver, {KC_2, KC_3, KC_1, KC_8});
+    key_up.press();
+    run_one_scan_loop();
+    key_shift.release();
+    run_one_scan_loop();
+    key_up.release();
+    idle_for(100);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(get_mods(), 0);
+}
+
+TEST_F(UnicodeMapAsync, does_not_restore_mod_tap_released_meanwhile) {
+    TestDriver driver;
+    InSequence s;
+
+    auto key_mt = KeymapKey(0, 0, 0, LSFT_T(KC_A));
+    auto key_up = KeymapKey(0, 1, 0, UP(0, 1));
+
+    set_keymap({key_mt, key_up});
+
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    key_mt.press();
+    idle_for(TAPPING_TERM + 1);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    expect_async_unicode(driver, {KC_2, KC_3, KC_1, KC_8});
+    key_up.press();
+    run_one_scan_loop();
+    key_mt.release();
+    run_one_scan_loop();
+    key_up.release();
+    idle_for(100);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(get_mods(), 0);
+}
+
+TEST_F(UnicodeMapAsync, queued_code_points_are_typed_in_order) {
+    TestDriver driver;
+    InSequence s;
+
+    auto key_um0 = KeymapKey(0, 0, 0, UM(0));
+    auto key_um1 = KeymapKey(0, 1, 0, UM(1));
+
+    set_keymap({key_um0, key_um1});
+
+    expect_async_unicode(driver, {KC_0, KC_3, KC_A, KC_8});
+    expect_async_unicode(driver, {KC_2, KC_3, KC_1, KC_8});
+    key_um0.press();
+    run_one_scan_loop();
+    key_um1.press();
+    run_one_scan_loop();
+    key_um0.release();
+    key_um1.release();
+    idle_for(200);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(UnicodeMapAsync, drops_code_points_when_the_queue_is_full) {
+    TestDriver driver;
+    InSequence s;
+
+    auto key_um0 = KeymapKey(0, 0, 0, UM(0));
+    auto key_um1 = KeymapKey(0, 1, 0, UM(1));
+
+    set_keymap({key_um0, key_um1});
+
+    /* One sequence is being typed and UNICODE_ASYNC_QUEUE_SIZE are waiting, the fourth key is dropped. */
+    expect_async_unicode(driver, {KC_0, KC_3, KC_A, KC_8});
+    expect_async_unicode(driver, {KC_2, KC_3, KC_1, KC_8});
+    expect_async_unicode(driver, {KC_0, KC_3, KC_A, KC_8});
+    tap_key(key_um0);
+    tap_key(key_um1);
+    tap_key(key_um0);
+    tap_key(key_um1);
+    idle_for(300);
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,9 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define VIA_BULK_BLOCK_SIZE 16
+#define VIA_BULK_WRITE_BUFFER_SIZE 64
@@ -0,0 +1,137 @@
+// Copyright 2023 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstring>
+#include <vector>
+#include "test_common.hpp"
+
+extern "C" {
+#include "via.h"
+#include "crc.h"
+}
+
+#define KEYMAP_BUFFER_SIZE 200
+
+static uint8_t keymap_buffer[KEYMAP_BUFFER_SIZE];
+static int     keymap_writes;
+
+extern "C" {
+uint16_t dynamic_keymap_get_buffer_size(void) {
+    return KEYMAP_BUFFER_SIZE;
+}
+
+void dynamic_keymap_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
+    memcpy(data, &keymap_buffer[offset], size);
+}
+
+void dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
+    keymap_writes++;
+    memcpy(&keymap_buffer[offset], data, size);
+}
+}
+
+class ViaBulkTransfer : public TestFixture {
+   public:
+    void SetUp() override {
+        for (int i = 0; i < KEYMAP_BUFFER_SIZE; i++) {
+            keymap_buffer[i] = i;
+        }
+        keymap_writes = 0;
+    }
+
+    std::vector<uint8_t> command(uint8_t command_id, uint8_t value_id, std::vector<uint8_t> value_data) {
+        std::vector<uint8_t> packet = {command_id, id_qmk_bulk_channel, value_id};
+        packet.insert(packet.end(), value_data.begin(), value_data.end());
+        packet.resize(32);
+        via_qmk_bulk_command(packet.data(), packet.size());
+        return packet;
+    }
+
+    uint8_t begin(uint16_t offset, uint16_t size) {
+        auto reply = command(id_custom_set_value, id_qmk_bulk_write_begin, {(uint8_t)(offset >> 8), (uint8_t)offset, (uint8_t)(size >> 8), (uint8_t)size});
+        return reply[7];
+    }
+
+    uint8_t write(uint8_t sequence, uint8_t fill, uint8_t size) {
+        std::vector<uint8_t> value_data(size + 1, fill);
+        value_data[0] = sequence;
+        auto reply    = command(id_custom_set_value, id_qmk_bulk_write_data, value_data);
+        EXPECT_EQ(reply[3], sequence);
+        return reply[4];
+    }
+
+    uint8_t commit(void) {
+        return command(id_custom_set_value, id_qmk_bulk_write_commit, {})[3];
+    }
+};
+
+TEST_F(ViaBulkTransfer, ReturnsBlockCrcsUpToTheEndOfTheBuffer) {
+    // 200 bytes are 13 blocks of 16, the last one is 8 bytes long
+    auto reply = command(id_custom_get_value, id_qmk_bulk_buffer_crc, {0x00, 10, 25});
+
+    EXPECT_EQ(reply[0], id_custom_get_value);
+    EXPECT_EQ(reply[5], 3);
+    EXPECT_EQ(reply[6], 16);
+    EXPECT_EQ(reply[7], crc8(&keymap_buffer[160], 16));
+    EXPECT_EQ(reply[8], crc8(&keymap_buffer[176], 16));
+    EXPECT_EQ(reply[9], crc8(&keymap_buffer[192], 8));
+}
+
+TEST_F(ViaBulkTransfer, TrimsTheCrcCountToThePacket) {
+    auto reply = command(id_custom_get_value, id_qmk_bulk_buffer_crc, {0x00, 0x00, 0xFF});
+
+    EXPECT_EQ(reply[5], 13);
+
+    reply = command(id_custom_get_value, id_qmk_bulk_buffer_crc, {0x00, 13, 1});
+    EXPECT_EQ(reply[5], 0);
+}
+
+TEST_F(ViaBulkTransfer, WritesToEepromOnlyOnCommit) {
+    ASSERT_EQ(begin(100, 60), id_bulk_ok);
+    EXPECT_EQ(command(id_custom_set_value, id_qmk_bulk_write_begin, {0x00, 100, 0x00, 60})[8], 28);
+
+    EXPECT_EQ(write(0, 0xA1, 28), id_bulk_ok);
+    EXPECT_EQ(write(1, 0xA2, 28), id_bulk_ok);
+    EXPECT_EQ(write(2, 0xA3, 4), id_bulk_ok);
+    EXPECT_EQ(keymap_writes, 0);
+    EXPECT_EQ(keymap_buffer[100], 100);
+
+    EXPECT_EQ(commit(), id_bulk_ok);
+    EXPECT_EQ(keymap_writes, 1);
+    EXPECT_EQ(keymap_buffer[99], 99);
+    EXPECT_EQ(keymap_buffer[100], 0xA1);
+    EXPECT_EQ(keymap_buffer[128], 0xA2);
+    EXPECT_EQ(keymap_buffer[159], 0xA3);
+    EXPECT_EQ(keymap_buffer[160], 160);
+}
+
+TEST_F(ViaBulkTransfer, RejectsSessionsLargerThanTheWriteBuffer) {
+    EXPECT_EQ(begin(0, VIA_BULK_WRITE_BUFFER_SIZE + 1), id_bulk_out_of_range);
+    EXPECT_EQ(begin(KEYMAP_BUFFER_SIZE - 10, 11), id_bulk_out_of_range);
+    EXPECT_EQ(begin(0, 0), id_bulk_out_of_range);
+    EXPECT_EQ(write(0, 0xA1, 28), id_bulk_no_session);
+    EXPECT_EQ(commit(), id_bulk_no_session);
+    EXPECT_EQ(keymap_writes, 0);
+}
+
+TEST_F(ViaBulkTransfer, SequenceGapAbortsWithoutWriting) {
+    ASSERT_EQ(begin(0, 40), id_bulk_ok);
+    EXPECT_EQ(write(0, 0xA1, 28), id_bulk_ok);
+    EXPECT_EQ(write(2, 0xA2, 12), id_bulk_bad_sequence);
+    EXPECT_EQ(commit(), id_bulk_no_session);
+    EXPECT_EQ(keymap_writes, 0);
+    EXPECT_EQ(keymap_buffer[0], 0);
+}
+
+TEST_F(ViaBulkTransfer, IncompleteSessionIsNotWritten) {
+    ASSERT_EQ(begin(0, 40), id_bulk_ok);
+    EXPECT_EQ(write(0, 0xA1, 28), id_bulk_ok);
+    EXPECT_EQ(commit(), id_bulk_incomplete);
+    EXPECT_EQ(keymap_writes, 0);
+}
+
+TEST_F(ViaBulkTransfer, UnknownValueIsUnhandled) {
+    EXPECT_EQ(command(id_custom_set_value, id_qmk_bulk_buffer_crc, {})[0], id_unhandled);
+    EXPECT_EQ(command(id_custom_get_value, id_qmk_bulk_write_commit, {})[0], id_unhandled);
+    EXPECT_EQ(command(id_custom_save, id_qmk_bulk_write_commit, {})[0], id_unhandled);
+}
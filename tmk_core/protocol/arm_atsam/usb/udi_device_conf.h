@@ -437,7 +437,11 @@ typedef struct {
 } udi_hid_mou_desc_t;
 
 typedef struct {
+#    ifdef WHEEL_EXTENDED_REPORT
+    uint8_t array[81]; // MOU PDS
+#    else
     uint8_t array[77]; // MOU PDS
+#    endif
 } udi_hid_mou_report_desc_t;
 
 // clang-format off
@@ -476,7 +480,11 @@ typedef struct {
 // clang-format on
 
 // report buffer
-#    define UDI_HID_MOU_REPORT_SIZE 5 // MOU PDS
+#    ifdef WHEEL_EXTENDED_REPORT
+#        define UDI_HID_MOU_REPORT_SIZE 7 // MOU PDS
+#    else
+#        define UDI_HID_MOU_REPORT_SIZE 5 // MOU PDS
+#    endif
 extern uint8_t udi_hid_mou_report[UDI_HID_MOU_REPORT_SIZE];
 
 COMPILER_PACK_RESET()
@@ -44,6 +44,7 @@
 #include "usb_descriptor.h"
 #include "usb_driver.h"
 #include "usb_types.h"
+#include "ring_buffer.h"
 
 #ifdef NKRO_ENABLE
 #    include "keycode_config.h"
@@ -52,8 +53,8 @@ extern keymap_config_t keymap_config;
 #endif
 
 #if defined(CONSOLE_ENABLE)
-#    define RBUF_SIZE 256
-#    include "ring_buffer.h"
+RING_BUFFER_DEFINE_INDEXED(console_queue, uint8_t, 256, uint16_t);
+static console_queue_t console_buffer;
 #endif
 
 /* ---------------------------------------------------------
@@ -422,34 +423,20 @@ static usb_driver_configs_t drivers = {
  */
 
 #define USB_EVENT_QUEUE_SIZE 16
-usbevent_t event_queue[USB_EVENT_QUEUE_SIZE];
-uint8_t    event_queue_head;
-uint8_t    event_queue_tail;
+RING_BUFFER_DEFINE(usb_event_queue, usbevent_t, USB_EVENT_QUEUE_SIZE);
+static usb_event_queue_t usb_events;
 
 void usb_event_queue_init(void) {
     // Initialise the event queue
-    memset(&event_queue, 0, sizeof(event_queue));
-    event_queue_head = 0;
-    event_queue_tail = 0;
+    memset(&usb_events, 0, sizeof(usb_events));
 }
 
 static inline bool usb_event_queue_enqueue(usbevent_t event) {
-    uint8_t next = (event_queue_head + 1) % USB_EVENT_QUEUE_SIZE;
-    if (next == event_queue_tail) {
-        return false;
-    }
-    event_queue[event_queue_head] = event;
-    event_queue_head              = next;
-    return true;
+    return usb_event_queue_push(&usb_events, event);
 }
 
 static inline bool usb_event_queue_dequeue(usbevent_t *event) {
-    if (event_queue_head == event_queue_tail) {
-        return false;
-    }
-    *event           = event_queue[event_queue_tail];
-    event_queue_tail = (event_queue_tail + 1) % USB_EVENT_QUEUE_SIZE;
-    return true;
+    return usb_event_queue_pop(&usb_events, event);
 }
 
 static inline void usb_event_suspend_handler(void) {
@@ -931,12 +918,12 @@ void send_digitizer(report_digitizer_t *report) {
 #ifdef CONSOLE_ENABLE
 
 int8_t sendchar(uint8_t c) {
-    rbuf_enqueue(c);
+    console_queue_push(&console_buffer, c);
     return 0;
 }
 
 void console_task(void) {
-    if (!rbuf_has_data()) {
+    if (console_queue_empty(&console_buffer)) {
         return;
     }
 
@@ -954,8 +941,9 @@ void console_task(void) {
     // Send in chunks - padded with zeros to 32
     char    send_buf[CONSOLE_EPSIZE] = {0};
     uint8_t send_buf_count           = 0;
-    while (rbuf_has_data() && send_buf_count < CONSOLE_EPSIZE) {
-        send_buf[send_buf_count++] = rbuf_dequeue();
+    uint8_t c;
+    while (send_buf_count < CONSOLE_EPSIZE && console_queue_pop(&console_buffer, &c)) {
+        send_buf[send_buf_count++] = c;
     }
 
     usbStartTransmitI(&USB_DRIVER, CONSOLE_IN_EPNUM, (const uint8_t *)send_buf, CONSOLE_EPSIZE);
@@ -973,6 +961,15 @@ void raw_hid_send(uint8_t *data, uint8_t length) {
     chnWrite(&drivers.raw_driver.driver, data, length);
 }
 
+#    ifdef RAW_HID_ROUTER_ENABLE
+bool raw_hid_send_ready(void) {
+    osalSysLock();
+    bool ready = usbGetDriverStateI(&USB_DRIVER) == USB_ACTIVE && !obqIsFullI(&drivers.raw_driver.driver.obqueue);
+    osalSysUnlock();
+    return ready;
+}
+#    endif
+
 __attribute__((weak)) void raw_hid_receive(uint8_t *data, uint8_t length) {
     // Users should #include "raw_hid.h" in their own code
     // and implement this function there. Leave this as weak linkage
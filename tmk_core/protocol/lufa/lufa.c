@@ -137,6 +137,22 @@ void raw_hid_send(uint8_t *data, uint8_t length) {
     send_report(RAW_IN_EPNUM, data, RAW_EPSIZE);
 }
 
+#    ifdef RAW_HID_ROUTER_ENABLE
+/** \brief Raw HID Send Ready
+ *
+ * Whether the IN endpoint can take a report without send_report() having to wait.
+ */
+bool raw_hid_send_ready(void) {
+    if (USB_DeviceState != DEVICE_STATE_Configured) return false;
+
+    uint8_t ep = Endpoint_GetCurrentEndpoint();
+    Endpoint_SelectEndpoint(RAW_IN_EPNUM);
+    bool ready = Endpoint_IsReadWriteAllowed();
+    Endpoint_SelectEndpoint(ep);
+    return ready;
+}
+#    endif
+
 /** \brief Raw HID Receive
  *
  * FIXME: Needs doc
@@ -40,8 +40,10 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #endif
 
 #if defined(CONSOLE_ENABLE)
-#    define RBUF_SIZE 128
 #    include "ring_buffer.h"
+
+RING_BUFFER_DEFINE(console_queue, uint8_t, 128);
+static console_queue_t console_buffer;
 #endif
 
 #ifdef OS_DETECTION_ENABLE
@@ -177,7 +179,7 @@ void raw_hid_task(void) {
 #    define CONSOLE_EPSIZE 8
 
 int8_t sendchar(uint8_t c) {
-    rbuf_enqueue(c);
+    console_queue_push(&console_buffer, c);
     return 0;
 }
 
@@ -186,15 +188,16 @@ void console_task(void) {
         return;
     }
 
-    if (!rbuf_has_data()) {
+    if (console_queue_empty(&console_buffer)) {
         return;
     }
 
     // Send in chunks of 8 padded to 32
     char    send_buf[CONSOLE_BUFFER_SIZE] = {0};
     uint8_t send_buf_count                = 0;
-    while (rbuf_has_data() && send_buf_count < CONSOLE_EPSIZE) {
-        send_buf[send_buf_count++] = rbuf_dequeue();
+    uint8_t c;
+    while (send_buf_count < CONSOLE_EPSIZE && console_queue_pop(&console_buffer, &c)) {
+        send_buf[send_buf_count++] = c;
     }
 
     send_report(3, send_buf, CONSOLE_BUFFER_SIZE);
@@ -516,20 +519,34 @@ const PROGMEM uchar shared_hid_report[] = {
 #    endif
     0x81, 0x06, //     Input (Data, Variable, Relative)
 
-    // Vertical wheel (1 byte)
+    // Vertical wheel (1 or 2 bytes)
     0x09, 0x38, //     Usage (Wheel)
+#    ifndef WHEEL_EXTENDED_REPORT
     0x15, 0x81, //     Logical Minimum (-127)
     0x25, 0x7F, //     Logical Maximum (127)
     0x95, 0x01, //     Report Count (1)
     0x75, 0x08, //     Report Size (8)
+#    else
+    0x16, 0x01, 0x80, // Logical Minimum (-32767)
+    0x26, 0xFF, 0x7F, // Logical Maximum (32767)
+    0x95, 0x01,       // Report Count (1)
+    0x75, 0x10,       // Report Size (16)
+#    endif
     0x81, 0x06, //     Input (Data, Variable, Relative)
-    // Horizontal wheel (1 byte)
+    // Horizontal wheel (1 or 2 bytes)
     0x05, 0x0C,       //     Usage Page (Consumer)
     0x0A, 0x38, 0x02, //     Usage (AC Pan)
+#    ifndef WHEEL_EXTENDED_REPORT
     0x15, 0x81,       //     Logical Minimum (-127)
     0x25, 0x7F,       //     Logical Maximum (127)
     0x95, 0x01,       //     Report Count (1)
     0x75, 0x08,       //     Report Size (8)
+#    else
+    0x16, 0x01, 0x80, // Logical Minimum (-32767)
+    0x26, 0xFF, 0x7F, // Logical Maximum (32767)
+    0x95, 0x01,       // Report Count (1)
+    0x75, 0x10,       // Report Size (16)
+#    endif
     0x81, 0x06,       //     Input (Data, Variable, Relative)
     0xC0,             //   End Collection
     0xC0,             // End Collection